@@ -0,0 +1,225 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/* Allocators for short-lived parallel vectors and traits referencing them.
+ * Traits only store a pointer to the allocator, so they are cheap to copy; allocator should outlive all vectors using it. Allocators are not thread-safe.
+ * Usage: utl::monotonic_arena arena; utl::arena_parallel_vector<int, float> vec(arena); */
+
+namespace utl {
+
+/* Monotonic arena: allocation is a pointer bump inside current block, deallocation is no-op, all memory is freed at once by reset/release.
+ * Blocks grow geometrically; requests larger than the block size get a dedicated block. */
+class monotonic_arena
+{
+public:
+	explicit monotonic_arena(size_t initialBlockSize = 64 * 1024) : mNextBlockSize(initialBlockSize) {}
+	~monotonic_arena() { release(); }
+
+	monotonic_arena(const monotonic_arena &) = delete;
+	monotonic_arena &operator=(const monotonic_arena &) = delete;
+
+	/* Allocate memory with given alignment (power-of-two, at most alignof(max_align_t) unless block size is a multiple of it). */
+	void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+	{
+		char *start = align_up(mCurrent, alignment);
+		if (!start || start + bytes > mEnd)
+		{
+			add_block(bytes + alignment);
+			start = align_up(mCurrent, alignment);
+		}
+		mCurrent = start + bytes;
+		return start;
+	}
+
+	/* Forget all allocations, but keep the largest (most recent) block for reuse. */
+	void reset()
+	{
+		if (!mHead)
+			return;
+		free_blocks(mHead->prev);
+		mHead->prev = nullptr;
+		mCurrent = block_data(mHead);
+	}
+
+	/* Forget all allocations and free all memory. */
+	void release()
+	{
+		free_blocks(mHead);
+		mHead = nullptr;
+		mCurrent = mEnd = nullptr;
+	}
+
+private:
+	struct block
+	{
+		block	*prev;
+		size_t	size;	// including header
+	};
+	static const constexpr size_t kHeaderSize = sizeof(block) > alignof(std::max_align_t) ? sizeof(block) : alignof(std::max_align_t);
+
+	static char *align_up(char *ptr, size_t alignment)
+	{
+		return reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(ptr) + alignment - 1) & ~std::uintptr_t(alignment - 1));
+	}
+	static char *block_data(block *b) { return reinterpret_cast<char *>(b) + kHeaderSize; }
+
+	void add_block(size_t minBytes)
+	{
+		size_t size = mNextBlockSize > minBytes + kHeaderSize ? mNextBlockSize : minBytes + kHeaderSize;
+		block *b = static_cast<block *>(::operator new(size));
+		b->prev = mHead;
+		b->size = size;
+		mHead = b;
+		mCurrent = block_data(b);
+		mEnd = reinterpret_cast<char *>(b) + size;
+		mNextBlockSize = 2 * size;
+	}
+
+	static void free_blocks(block *b)
+	{
+		while (b)
+		{
+			block *prev = b->prev;
+			::operator delete(b);
+			b = prev;
+		}
+	}
+
+private:
+	block	*mHead			= nullptr;
+	char	*mCurrent		= nullptr;
+	char	*mEnd			= nullptr;
+	size_t	mNextBlockSize;
+};
+
+/* Size-class pool: blocks are rounded up to power-of-two sizes, freed blocks are kept in per-class free lists and handed out again on next allocation
+ * of the same class. Requests above the largest class go directly to the global heap. Cached blocks are freed by release or destructor. */
+class size_class_pool
+{
+public:
+	static const constexpr size_t kMinClassShift = 6;	// 64 bytes
+	static const constexpr size_t kNumClasses = 21;		// up to 64 MB
+
+	size_class_pool() = default;
+	~size_class_pool() { release(); }
+
+	size_class_pool(const size_class_pool &) = delete;
+	size_class_pool &operator=(const size_class_pool &) = delete;
+
+	/* Allocate block of at least given size, aligned to alignof(max_align_t). */
+	void *allocate(size_t bytes)
+	{
+		size_t sizeClass = size_class(bytes + kHeaderSize);
+		header *h;
+		if (sizeClass < kNumClasses && mFreeLists[sizeClass])
+		{
+			h = mFreeLists[sizeClass];
+			mFreeLists[sizeClass] = h->next;
+		}
+		else
+		{
+			h = static_cast<header *>(::operator new(sizeClass < kNumClasses ? size_t(1) << (sizeClass + kMinClassShift) : bytes + kHeaderSize));
+		}
+		h->sizeClass = sizeClass;
+		return reinterpret_cast<char *>(h) + kHeaderSize;
+	}
+
+	/* Return block to the pool. */
+	void deallocate(void *ptr)
+	{
+		if (!ptr)
+			return;
+
+		header *h = reinterpret_cast<header *>(static_cast<char *>(ptr) - kHeaderSize);
+		if (h->sizeClass >= kNumClasses)
+		{
+			::operator delete(h);
+			return;
+		}
+		h->next = mFreeLists[h->sizeClass];
+		mFreeLists[h->sizeClass] = h;
+	}
+
+	/* Free all cached blocks (blocks currently in use are not affected). */
+	void release()
+	{
+		for (auto &list : mFreeLists)
+		{
+			while (list)
+			{
+				header *next = list->next;
+				::operator delete(list);
+				list = next;
+			}
+		}
+	}
+
+private:
+	struct header
+	{
+		size_t	sizeClass;
+		header	*next;		// only used while block is in free list
+	};
+	static const constexpr size_t kHeaderSize = sizeof(header) > alignof(std::max_align_t) ? sizeof(header) : alignof(std::max_align_t);
+
+	/* Index of the smallest class that fits given size, kNumClasses or more if it doesn't fit any. */
+	static size_t size_class(size_t bytes)
+	{
+		size_t sizeClass = 0;
+		while ((size_t(1) << (sizeClass + kMinClassShift)) < bytes && sizeClass < kNumClasses)
+			++sizeClass;
+		return sizeClass;
+	}
+
+private:
+	header	*mFreeLists[kNumClasses] = {};
+};
+
+/* Traits allocating from monotonic arena; memory is reclaimed only when arena is reset. Implicitly constructible from arena reference. */
+struct arena_parallel_vector_traits : default_parallel_vector_traits
+{
+	arena_parallel_vector_traits(monotonic_arena &arena) : mArena(&arena) {}
+
+	void *allocate(size_t bytes)
+	{
+		return bytes > 0 ? mArena->allocate(bytes) : nullptr;
+	}
+
+	void deallocate(void *) {}
+
+private:
+	monotonic_arena *mArena;
+};
+
+/* Traits allocating from size-class pool. Implicitly constructible from pool reference. */
+struct pool_parallel_vector_traits : default_parallel_vector_traits
+{
+	pool_parallel_vector_traits(size_class_pool &pool) : mPool(&pool) {}
+
+	void *allocate(size_t bytes)
+	{
+		return bytes > 0 ? mPool->allocate(bytes) : nullptr;
+	}
+
+	void deallocate(void *ptr)
+	{
+		mPool->deallocate(ptr);
+	}
+
+private:
+	size_class_pool *mPool;
+};
+
+/* Parallel vectors using arena or pool; should be constructed with allocator reference. */
+template<typename... Types>
+using arena_parallel_vector = detail::parallel_vector_impl<detail::type_list<Types...>, arena_parallel_vector_traits>;
+
+template<typename... Types>
+using pool_parallel_vector = detail::parallel_vector_impl<detail::type_list<Types...>, pool_parallel_vector_traits>;
+
+}
@@ -1,14 +1,20 @@
 #pragma once
 
+#include <cstddef>
 #include <iterator>
+#include <stdexcept>
+#include <type_traits>
 
 namespace utl {
 
 /* Array view is a non-owning contiguous range of elements. It can describe a subrange in STL array or vector, built-in array, and other similar structures.
- * It allows familiar iteration methods (range-based for, begin()/end(), data()/size(), etc.). */
-template<typename T>
+ * It allows familiar iteration methods (range-based for, begin()/end(), data()/size(), etc.).
+ * Alignment is a compile-time guarantee about the start pointer (e.g. parallel_vector slices with aligned traits), so that kernels can use aligned loads without runtime checks. */
+template<typename T, size_t Alignment = alignof(T)>
 class array_view
 {
+	static_assert((Alignment & (Alignment - 1)) == 0 && Alignment >= alignof(T), "Alignment should be power-of-two and not less than natural alignment");
+
 public:
 	// Exposed typedefs
 	typedef T value_type;
@@ -23,12 +29,18 @@ public:
 	typedef std::reverse_iterator<iterator> reverse_iterator;
 	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
+	static const constexpr size_t alignment = Alignment;
+
 	/* Default constructor creates empty range. */
 	array_view() : mBegin(nullptr), mEnd(nullptr) {}
 
 	/* Constructor: range defined by two pointers: [begin, end). */
 	array_view(T *begin, T *end) : mBegin(begin), mEnd(end) {}
 
+	/* Conversion from view with stricter alignment guarantee. */
+	template<size_t OtherAlignment, typename = std::enable_if_t<(OtherAlignment > Alignment)>>
+	array_view(array_view<T, OtherAlignment> rhs) : mBegin(rhs.begin()), mEnd(rhs.end()) {}
+
 	/* Note: default copy/move/assignment/dtor are perfectly fine. */
 
 	// Element access
@@ -70,7 +82,7 @@ public:
 
 private:
 	/* Throw std::out_of_range if condition is true. */
-	void throw_out_of_range_if(bool condition)
+	static void throw_out_of_range_if(bool condition)
 	{
 		if (condition)
 			throw std::out_of_range("Index out of range");
@@ -97,4 +109,10 @@ template<typename T, size_t N> array_view<T> make_array_view(T (&arr)[N])
 	return array_view<T>(arr, arr + N);
 }
 
+/* Create array view with alignment guarantee; caller is responsible for start pointer being properly aligned. */
+template<size_t Alignment, typename T> array_view<T, Alignment> make_aligned_array_view(T *start, size_t size)
+{
+	return array_view<T, Alignment>(start, start + size);
+}
+
 }
@@ -0,0 +1,94 @@
+#include "bench_common.h"
+#include "../column_kernels.h"
+#include "../parallel_vector.h"
+
+#include <stdlib.h>
+
+/* Naive loops over array views, as typically written by users. */
+template<typename View>
+auto naive_sum(View view)
+{
+	utl::detail::sum_type_t<std::remove_const_t<typename View::value_type>> result = 0;
+	for (auto v : view)
+		result += v;
+	return result;
+}
+
+template<typename View>
+size_t naive_argmin(View view)
+{
+	size_t result = 0;
+	for (size_t i = 1; i < view.size(); ++i)
+		if (view[i] < view[result])
+			result = i;
+	return result;
+}
+
+template<typename View, typename T>
+size_t naive_count_less(View view, T value)
+{
+	size_t result = 0;
+	for (auto v : view)
+		if (v < value)
+			++result;
+	return result;
+}
+
+template<typename InView, typename OutView>
+void naive_inclusive_scan(InView in, OutView out)
+{
+	typename OutView::value_type running = 0;
+	for (size_t i = 0; i < in.size(); ++i)
+		out[i] = running += in[i];
+}
+
+template<size_t Index, typename Vec>
+void bench_column(const char *typeName, Vec &vec)
+{
+	const int kRepetitions = 10;
+	auto in = vec.template slice<Index>();
+	auto out = vec.template slice<Index + 1>();
+	size_t count = in.size();
+	char name[128];
+
+	double naive = bench::best_time_ns(kRepetitions, [&] { bench::do_not_optimize(naive_sum(in)); });
+	double fast = bench::best_time_ns(kRepetitions, [&] { bench::do_not_optimize(utl::kernels::sum(in)); });
+	snprintf(name, sizeof(name), "sum<%s> naive", typeName); bench::report(name, count, naive);
+	snprintf(name, sizeof(name), "sum<%s> kernel", typeName); bench::report(name, count, fast, naive);
+
+	naive = bench::best_time_ns(kRepetitions, [&] { bench::do_not_optimize(naive_argmin(in)); });
+	fast = bench::best_time_ns(kRepetitions, [&] { bench::do_not_optimize(utl::kernels::argmin(in)); });
+	snprintf(name, sizeof(name), "argmin<%s> naive", typeName); bench::report(name, count, naive);
+	snprintf(name, sizeof(name), "argmin<%s> kernel", typeName); bench::report(name, count, fast, naive);
+
+	auto threshold = in[count / 2];
+	naive = bench::best_time_ns(kRepetitions, [&] { bench::do_not_optimize(naive_count_less(in, threshold)); });
+	fast = bench::best_time_ns(kRepetitions, [&] { bench::do_not_optimize(utl::kernels::count_if(in, utl::compare_op::less, threshold)); });
+	snprintf(name, sizeof(name), "count_if<%s> naive", typeName); bench::report(name, count, naive);
+	snprintf(name, sizeof(name), "count_if<%s> kernel", typeName); bench::report(name, count, fast, naive);
+
+	naive = bench::best_time_ns(kRepetitions, [&] { naive_inclusive_scan(in, out); bench::do_not_optimize(out[count - 1]); });
+	fast = bench::best_time_ns(kRepetitions, [&] { utl::kernels::inclusive_scan(in, out); bench::do_not_optimize(out[count - 1]); });
+	snprintf(name, sizeof(name), "inclusive_scan<%s> naive", typeName); bench::report(name, count, naive);
+	snprintf(name, sizeof(name), "inclusive_scan<%s> kernel", typeName); bench::report(name, count, fast, naive);
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+
+	// each input column is followed by output column of the same type
+	utl::parallel_vector<float, float, double, double, int32_t, int32_t> vec(static_cast<uint32_t>(count));
+	uint32_t seed = 12345;
+	for (size_t i = 0; i < count; ++i)
+	{
+		seed = seed * 1664525 + 1013904223;
+		int32_t v = int32_t(seed >> 16) - 32768;
+		vec.push_back(float(v), 0.0f, double(v), 0.0, v, 0);
+	}
+
+	bench_column<0>("float", vec);
+	bench_column<2>("double", vec);
+	bench_column<4>("int32", vec);
+	return 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Keep benchmarked function out of line, so that its code can be inspected in disassembly. */
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace bench {
+
+/* Prevent compiler from optimizing away computation which produced the value. */
+template<typename T>
+inline void do_not_optimize(const T &value)
+{
+#if defined(__GNUC__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const T *sink;
+	sink = &value;
+#endif
+}
+
+/* Run functor several times and return best wall time in nanoseconds.
+ * Setup functor is called before each run and is not timed. */
+template<typename Setup, typename Func>
+double best_time_ns(int repetitions, Setup &&setup, Func &&func)
+{
+	double best = 1e300;
+	for (int i = 0; i < repetitions; ++i)
+	{
+		setup();
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto finish = std::chrono::steady_clock::now();
+		best = std::min(best, std::chrono::duration<double, std::nano>(finish - start).count());
+	}
+	return best;
+}
+
+template<typename Func>
+double best_time_ns(int repetitions, Func &&func)
+{
+	return best_time_ns(repetitions, [] {}, std::forward<Func>(func));
+}
+
+/* Print single result line: name, element count, total time, time per element and optionally baseline ratio. */
+inline void report(const char *name, size_t count, double ns, double baselineNs = 0)
+{
+	printf("%-48s %10zu %12.3f ms %8.3f ns/op", name, count, ns * 1e-6, count > 0 ? ns / count : 0.0);
+	if (baselineNs > 0)
+		printf("   x%.2f", baselineNs / ns);
+	printf("\n");
+}
+
+/* Same as report, additionally printing amount of memory moved (or read, for scans) and resulting throughput. */
+inline void report_traffic(const char *name, size_t count, double ns, double bytes, double baselineNs = 0)
+{
+	printf("%-48s %10zu %12.3f ms %8.3f ns/op %10.1f MB %7.2f GB/s", name, count, ns * 1e-6, count > 0 ? ns / count : 0.0, bytes * 1e-6, ns > 0 ? bytes / ns : 0.0);
+	if (baselineNs > 0)
+		printf("   x%.2f", baselineNs / ns);
+	printf("\n");
+}
+
+}
@@ -0,0 +1,80 @@
+#include "bench_common.h"
+#include "../concurrent_parallel_vector.h"
+#include "../parallel_vector.h"
+
+#include <memory>
+#include <mutex>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+/* Many producers appending rows into one container: mutex around parallel_vector::push_back vs concurrent_parallel_vector push_back
+ * (claim + construct + publish per row) vs batched claim/publish of 256 rows. Total row count is fixed and split between 1..64 threads;
+ * thread start/join is included in the timing. Note that scaling is bounded by the number of hardware threads of the machine. */
+using locked_vector = utl::parallel_vector<int, float, double>;
+using concurrent_vector = utl::concurrent_parallel_vector<int, float, double>;
+
+template<typename Producer>
+void run_producers(size_t numThreads, size_t count, Producer &&producer)
+{
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < numThreads; ++t)
+	{
+		size_t begin = count * t / numThreads, end = count * (t + 1) / numThreads;
+		threads.emplace_back([&producer, begin, end] { producer(begin, end); });
+	}
+	for (auto &thread : threads)
+		thread.join();
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4000000;
+	const size_t kBatchRows = 256;
+	printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+	for (size_t numThreads = 1; numThreads <= 64; numThreads *= 2)
+	{
+		std::unique_ptr<locked_vector> locked;
+		std::mutex mutex;
+		double lockedNs = bench::best_time_ns(3, [&] { locked = std::make_unique<locked_vector>(); }, [&] {
+			run_producers(numThreads, count, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					locked->push_back(int(i), float(i), double(i));
+				}
+			});
+		});
+
+		std::unique_ptr<concurrent_vector> concurrent;
+		double concurrentNs = bench::best_time_ns(3, [&] { concurrent = std::make_unique<concurrent_vector>(); }, [&] {
+			run_producers(numThreads, count, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					concurrent->push_back(int(i), float(i), double(i));
+			});
+		});
+		double batchedNs = bench::best_time_ns(3, [&] { concurrent = std::make_unique<concurrent_vector>(); }, [&] {
+			run_producers(numThreads, count, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; i += kBatchRows)
+				{
+					size_t n = std::min(kBatchRows, end - i);
+					size_t first = concurrent->claim(n);
+					for (size_t k = 0; k < n; ++k)
+						concurrent->emplace(first + k, int(i + k), float(i + k), double(i + k));
+					concurrent->publish(first, n);
+				}
+			});
+		});
+		bench::do_not_optimize(concurrent->size());
+
+		char name[64];
+		snprintf(name, sizeof(name), "%2zu threads: mutex + push_back", numThreads);
+		bench::report(name, count, lockedNs);
+		snprintf(name, sizeof(name), "%2zu threads: concurrent push_back", numThreads);
+		bench::report(name, count, concurrentNs, lockedNs);
+		snprintf(name, sizeof(name), "%2zu threads: concurrent claim/publish x%zu", numThreads, kBatchRows);
+		bench::report(name, count, batchedNs, lockedNs);
+	}
+	return 0;
+}
@@ -0,0 +1,299 @@
+#include "bench_common.h"
+#include "../parallel_vector.h"
+#include "../strong_typedef.h"
+
+#include <stdlib.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/* Comparison of parallel_vector with array of structures (std::vector<struct>) and manual structure of arrays (std::tuple<std::vector<T>...>)
+ * on common operations, for element counts from 1K up to given maximum (default 1M; pass 100000000 to go up to 100M) and several type mixes.
+ * Each row reports time per operation and estimated memory traffic: bytes relocated by growth/insert/erase, or bytes read by scans
+ * (array of structures always reads whole rows). Ratio is relative to std::vector<struct>. */
+
+/* Type mixes: key (A), payload (B) and value (C); scans read A and C only. */
+struct pod_mix
+{
+	using A = int32_t;
+	using B = float;
+	using C = double;
+	static const char *name() { return "pod"; }
+	static A a(size_t i) { return int32_t(i & 0xFFFF); }
+	static B b(size_t i) { return float(i); }
+	static C c(size_t i) { return double(i & 0xFF) * 0.5; }
+	static double num(A &a) { return a; }
+	static double num(C &c) { return c; }
+};
+
+struct string_mix
+{
+	using A = int32_t;
+	using B = std::string;
+	using C = double;
+	static const char *name() { return "string"; }
+	static A a(size_t i) { return int32_t(i & 0xFFFF); }
+	static B b(size_t i) { return "name_" + std::to_string(i % 1000); }
+	static C c(size_t i) { return double(i & 0xFF) * 0.5; }
+	static double num(A &a) { return a; }
+	static double num(C &c) { return c; }
+};
+
+STRONG_TYPEDEF(entity_id, int32_t);
+STRONG_TYPEDEF(mass, float);
+STRONG_TYPEDEF(speed, double);
+
+struct typedef_mix
+{
+	using A = entity_id;
+	using B = mass;
+	using C = speed;
+	static const char *name() { return "strong_typedef"; }
+	static A a(size_t i) { return entity_id(int32_t(i & 0xFFFF)); }
+	static B b(size_t i) { return mass(float(i)); }
+	static C c(size_t i) { return speed(double(i & 0xFF) * 0.5); }
+	static double num(A &a) { return static_cast<int32_t &>(a); }
+	static double num(C &c) { return static_cast<double &>(c); }
+};
+
+/* Container adapters with uniform interface. */
+template<typename Mix>
+struct parallel_vector_adapter
+{
+	using A = typename Mix::A; using B = typename Mix::B; using C = typename Mix::C;
+	using container = utl::parallel_vector<A, B, C>;
+	static const constexpr size_t row_bytes = sizeof(A) + sizeof(B) + sizeof(C);
+	static const constexpr size_t single_scan_bytes = sizeof(A);
+	static const constexpr size_t multi_scan_bytes = sizeof(A) + sizeof(C);
+	static const char *name() { return "parallel_vector"; }
+
+	static void push_back(container &v, size_t i) { v.push_back(Mix::a(i), Mix::b(i), Mix::c(i)); }
+	static size_t size(const container &v) { return v.size(); }
+	static size_t capacity(const container &v) { return v.capacity(); }
+	static void reserve(container &v, size_t n) { v.reserve(static_cast<uint32_t>(n)); }
+	static void insert_copy(container &v, size_t pos, const container &src) { v.insert_copy(static_cast<uint32_t>(pos), src, 0, 1); }
+	static void insert_move(container &v, size_t pos, container &src) { v.insert_move(static_cast<uint32_t>(pos), src, 0, 1); }
+	static void erase(container &v, size_t pos) { v.erase(static_cast<uint32_t>(pos), static_cast<uint32_t>(pos + 1)); }
+
+	static double scan_single(container &v)
+	{
+		double sum = 0;
+		for (auto &a : v.template slice<0>())
+			sum += Mix::num(a);
+		return sum;
+	}
+	static double scan_multi(container &v)
+	{
+		auto a = v.template slice<0>();
+		auto c = v.template slice<2>();
+		double sum = 0;
+		for (size_t i = 0; i < a.size(); ++i)
+			sum += Mix::num(a[i]) * Mix::num(c[i]);
+		return sum;
+	}
+};
+
+template<typename Mix>
+struct aos_row
+{
+	typename Mix::A a;
+	typename Mix::B b;
+	typename Mix::C c;
+};
+
+template<typename Mix>
+struct vector_of_structs_adapter
+{
+	using container = std::vector<aos_row<Mix>>;
+	static const constexpr size_t row_bytes = sizeof(aos_row<Mix>);
+	static const constexpr size_t single_scan_bytes = row_bytes;
+	static const constexpr size_t multi_scan_bytes = row_bytes;
+	static const char *name() { return "vector<struct>"; }
+
+	static void push_back(container &v, size_t i) { v.push_back({ Mix::a(i), Mix::b(i), Mix::c(i) }); }
+	static size_t size(const container &v) { return v.size(); }
+	static size_t capacity(const container &v) { return v.capacity(); }
+	static void reserve(container &v, size_t n) { v.reserve(n); }
+	static void insert_copy(container &v, size_t pos, const container &src) { v.insert(v.begin() + pos, src.begin(), src.begin() + 1); }
+	static void insert_move(container &v, size_t pos, container &src)
+	{
+		v.insert(v.begin() + pos, std::make_move_iterator(src.begin()), std::make_move_iterator(src.begin() + 1));
+		src.erase(src.begin());
+	}
+	static void erase(container &v, size_t pos) { v.erase(v.begin() + pos); }
+
+	static double scan_single(container &v)
+	{
+		double sum = 0;
+		for (auto &row : v)
+			sum += Mix::num(row.a);
+		return sum;
+	}
+	static double scan_multi(container &v)
+	{
+		double sum = 0;
+		for (auto &row : v)
+			sum += Mix::num(row.a) * Mix::num(row.c);
+		return sum;
+	}
+};
+
+template<typename Mix>
+struct tuple_of_vectors_adapter
+{
+	using A = typename Mix::A; using B = typename Mix::B; using C = typename Mix::C;
+	using container = std::tuple<std::vector<A>, std::vector<B>, std::vector<C>>;
+	static const constexpr size_t row_bytes = sizeof(A) + sizeof(B) + sizeof(C);
+	static const constexpr size_t single_scan_bytes = sizeof(A);
+	static const constexpr size_t multi_scan_bytes = sizeof(A) + sizeof(C);
+	static const char *name() { return "tuple<vector...>"; }
+
+	static void push_back(container &v, size_t i)
+	{
+		std::get<0>(v).push_back(Mix::a(i));
+		std::get<1>(v).push_back(Mix::b(i));
+		std::get<2>(v).push_back(Mix::c(i));
+	}
+	static size_t size(const container &v) { return std::get<0>(v).size(); }
+	static size_t capacity(const container &v) { return std::get<0>(v).capacity(); }
+	static void reserve(container &v, size_t n) { std::get<0>(v).reserve(n); std::get<1>(v).reserve(n); std::get<2>(v).reserve(n); }
+	static void insert_copy(container &v, size_t pos, const container &src)
+	{
+		std::get<0>(v).insert(std::get<0>(v).begin() + pos, std::get<0>(src).front());
+		std::get<1>(v).insert(std::get<1>(v).begin() + pos, std::get<1>(src).front());
+		std::get<2>(v).insert(std::get<2>(v).begin() + pos, std::get<2>(src).front());
+	}
+	static void insert_move(container &v, size_t pos, container &src)
+	{
+		std::get<0>(v).insert(std::get<0>(v).begin() + pos, std::move(std::get<0>(src).front()));
+		std::get<1>(v).insert(std::get<1>(v).begin() + pos, std::move(std::get<1>(src).front()));
+		std::get<2>(v).insert(std::get<2>(v).begin() + pos, std::move(std::get<2>(src).front()));
+		std::get<0>(src).erase(std::get<0>(src).begin());
+		std::get<1>(src).erase(std::get<1>(src).begin());
+		std::get<2>(src).erase(std::get<2>(src).begin());
+	}
+	static void erase(container &v, size_t pos)
+	{
+		std::get<0>(v).erase(std::get<0>(v).begin() + pos);
+		std::get<1>(v).erase(std::get<1>(v).begin() + pos);
+		std::get<2>(v).erase(std::get<2>(v).begin() + pos);
+	}
+
+	static double scan_single(container &v)
+	{
+		double sum = 0;
+		for (auto &a : std::get<0>(v))
+			sum += Mix::num(a);
+		return sum;
+	}
+	static double scan_multi(container &v)
+	{
+		auto &a = std::get<0>(v);
+		auto &c = std::get<2>(v);
+		double sum = 0;
+		for (size_t i = 0; i < a.size(); ++i)
+			sum += Mix::num(a[i]) * Mix::num(c[i]);
+		return sum;
+	}
+};
+
+/* Results of all operations for single container & count; times are per whole operation batch. */
+struct results
+{
+	double ns[7] = {};
+	double bytes[7] = {};
+};
+
+static const char *const kOperationNames[] = { "push_back", "reserve growth", "insert_copy", "insert_move", "erase", "scan 1 slice", "scan 2 slices" };
+static const size_t kNumShifts = 16; // number of single-row inserts/erases in the middle
+
+template<typename Adapter>
+void fill(typename Adapter::container &v, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+		Adapter::push_back(v, i);
+}
+
+template<typename Adapter>
+results run(size_t count)
+{
+	using container = typename Adapter::container;
+	int reps = count >= 10000000 ? 1 : count >= 100000 ? 3 : 10;
+	results r;
+
+	// push_back from empty; bytes moved are relocations during growth, counted in separate untimed pass
+	r.ns[0] = bench::best_time_ns(reps, [&] { container v; fill<Adapter>(v, count); bench::do_not_optimize(Adapter::size(v)); });
+	{
+		container v;
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (Adapter::size(v) == Adapter::capacity(v))
+				r.bytes[0] += double(Adapter::size(v)) * Adapter::row_bytes;
+			Adapter::push_back(v, i);
+		}
+	}
+
+	container v;
+	r.ns[1] = bench::best_time_ns(reps, [&] { v = container(); fill<Adapter>(v, count); }, [&] { Adapter::reserve(v, 2 * Adapter::capacity(v) + 1); });
+	r.bytes[1] = double(count) * Adapter::row_bytes;
+
+	container src;
+	fill<Adapter>(src, kNumShifts);
+	double shiftBytes = double(kNumShifts) * (count / 2) * Adapter::row_bytes;
+	auto prepare = [&] { v = container(); Adapter::reserve(v, count + kNumShifts); fill<Adapter>(v, count); };
+	r.ns[2] = bench::best_time_ns(reps, prepare, [&] {
+		for (size_t i = 0; i < kNumShifts; ++i)
+			Adapter::insert_copy(v, Adapter::size(v) / 2, src);
+	});
+	container moveSrc;
+	r.ns[3] = bench::best_time_ns(reps, [&] { prepare(); moveSrc = src; }, [&] {
+		for (size_t i = 0; i < kNumShifts; ++i)
+			Adapter::insert_move(v, Adapter::size(v) / 2, moveSrc);
+	});
+	r.ns[4] = bench::best_time_ns(reps, prepare, [&] {
+		for (size_t i = 0; i < kNumShifts; ++i)
+			Adapter::erase(v, Adapter::size(v) / 2);
+	});
+	r.bytes[2] = r.bytes[3] = r.bytes[4] = shiftBytes;
+
+	prepare();
+	r.ns[5] = bench::best_time_ns(reps, [&] { bench::do_not_optimize(Adapter::scan_single(v)); });
+	r.ns[6] = bench::best_time_ns(reps, [&] { bench::do_not_optimize(Adapter::scan_multi(v)); });
+	r.bytes[5] = double(count) * Adapter::single_scan_bytes;
+	r.bytes[6] = double(count) * Adapter::multi_scan_bytes;
+	return r;
+}
+
+template<typename Mix>
+void run_mix(size_t count)
+{
+	results aos = run<vector_of_structs_adapter<Mix>>(count);
+	results pv = run<parallel_vector_adapter<Mix>>(count);
+	results tov = run<tuple_of_vectors_adapter<Mix>>(count);
+
+	char name[128];
+	for (size_t op = 0; op < 7; ++op)
+	{
+		size_t numOps = op >= 2 && op <= 4 ? kNumShifts : count;
+		snprintf(name, sizeof(name), "%s/%s/%s", kOperationNames[op], Mix::name(), vector_of_structs_adapter<Mix>::name());
+		bench::report_traffic(name, numOps, aos.ns[op], aos.bytes[op]);
+		snprintf(name, sizeof(name), "%s/%s/%s", kOperationNames[op], Mix::name(), parallel_vector_adapter<Mix>::name());
+		bench::report_traffic(name, numOps, pv.ns[op], pv.bytes[op], aos.ns[op]);
+		snprintf(name, sizeof(name), "%s/%s/%s", kOperationNames[op], Mix::name(), tuple_of_vectors_adapter<Mix>::name());
+		bench::report_traffic(name, numOps, tov.ns[op], tov.bytes[op], aos.ns[op]);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	size_t maxCount = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+
+	for (size_t count = 1000; count <= maxCount; count *= 10)
+	{
+		printf("=== %zu elements ===\n", count);
+		run_mix<pod_mix>(count);
+		run_mix<string_mix>(count);
+		run_mix<typedef_mix>(count);
+	}
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include "bench_common.h"
+#include "../tracked_parallel_vector.h"
+
+#include <random>
+#include <stdlib.h>
+#include <vector>
+
+/* Consumer keeping per-chunk sums of a slice up to date: either recomputes everything, or only chunks changed since last update. */
+using vec_type = utl::tracked_parallel_vector<float, int>;
+
+BENCH_NOINLINE void update_full(const vec_type &vec, std::vector<float> &sums)
+{
+	auto slice = vec.slice<0>();
+	for (size_t chunk = 0; chunk < vec.num_chunks(); ++chunk)
+	{
+		size_t first = chunk * vec_type::chunk_rows, last = std::min<size_t>(slice.size(), first + vec_type::chunk_rows);
+		float sum = 0;
+		for (size_t i = first; i < last; ++i)
+			sum += slice[i];
+		sums[chunk] = sum;
+	}
+}
+
+BENCH_NOINLINE void update_incremental(const vec_type &vec, std::vector<float> &sums, vec_type::version_type since)
+{
+	auto slice = vec.slice<0>();
+	vec.for_each_changed_chunk<0>(since, [&](uint32_t first, uint32_t last) {
+		float sum = 0;
+		for (size_t i = first; i < last; ++i)
+			sum += slice[i];
+		sums[first / vec_type::chunk_rows] = sum;
+	});
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4000000;
+
+	vec_type vec;
+	utl::parallel_vector<float, int> plain;
+	for (size_t i = 0; i < count; ++i)
+	{
+		vec.push_back(float(i % 100), int(i));
+		plain.push_back(float(i % 100), int(i));
+	}
+	std::vector<float> sums(vec.num_chunks());
+
+	std::mt19937 rng(42);
+	for (size_t numWrites : { size_t(100), size_t(1000), size_t(10000), count / 10 })
+	{
+		std::vector<uint32_t> rows(numWrites);
+		for (auto &r : rows)
+			r = static_cast<uint32_t>(rng() % count);
+
+		// producer: raw writes vs tracked writes
+		double rawWrites = bench::best_time_ns(5, [&] {
+			auto slice = plain.slice<0>();
+			for (uint32_t r : rows)
+				slice[r] += 1.0f;
+		});
+		double trackedWrites = bench::best_time_ns(5, [&] {
+			for (uint32_t r : rows)
+				vec.write<0>(r) += 1.0f;
+		});
+
+		// consumer: full rescan vs changed chunks only; writes are replayed before every run, untimed
+		vec_type::version_type checkpoint = 0;
+		auto produce = [&] {
+			checkpoint = vec.version();
+			for (uint32_t r : rows)
+				vec.write<0>(r) += 1.0f;
+		};
+		double full = bench::best_time_ns(5, produce, [&] { update_full(vec, sums); });
+		double incremental = bench::best_time_ns(5, produce, [&] { update_incremental(vec, sums, checkpoint); });
+
+		char name[128];
+		snprintf(name, sizeof(name), "%zu random writes, raw", numWrites); bench::report(name, numWrites, rawWrites);
+		snprintf(name, sizeof(name), "%zu random writes, tracked", numWrites); bench::report(name, numWrites, trackedWrites, rawWrites);
+		snprintf(name, sizeof(name), "%zu random writes, consumer full rescan", numWrites); bench::report(name, count, full);
+		snprintf(name, sizeof(name), "%zu random writes, consumer changed chunks (%zu)", numWrites, vec.changed_chunks<0>(checkpoint).size());
+		bench::report(name, count, incremental, full);
+	}
+	return 0;
+}
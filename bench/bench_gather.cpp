@@ -0,0 +1,86 @@
+#include "bench_common.h"
+#include "../parallel_vector_gather.h"
+
+#include <algorithm>
+#include <random>
+#include <stdlib.h>
+#include <vector>
+
+/* Large row payload, to show effect of prefetching. */
+struct payload
+{
+	double values[8];
+};
+
+using vec_type = utl::parallel_vector<int, double, payload>;
+
+/* Baseline: build result row by row. */
+BENCH_NOINLINE vec_type gather_push_back(const vec_type &src, const std::vector<uint32_t> &indices)
+{
+	vec_type result;
+	result.reserve(static_cast<vec_type::size_type>(indices.size()));
+	for (uint32_t i : indices)
+		result.push_back(src.slice<0>()[i], src.slice<1>()[i], src.slice<2>()[i]);
+	return result;
+}
+
+/* Single slice with given kernel, so that hardware gather and prefetching can be compared with plain loop. */
+template<typename T, typename Kernel>
+double bench_slice(const T *from, T *to, const std::vector<uint32_t> &indices, Kernel &&kernel)
+{
+	return bench::best_time_ns(5, [&] { kernel(to, from, indices.data(), indices.size()); });
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4000000;
+	size_t numIndices = count / 4;
+
+	vec_type src;
+	src.reserve(static_cast<vec_type::size_type>(count));
+	for (size_t i = 0; i < count; ++i)
+		src.push_back(int(i), double(i), payload{ { double(i) } });
+
+	std::mt19937 rng(42);
+	std::vector<uint32_t> randomIndices(numIndices), sortedIndices(numIndices);
+	for (auto &i : randomIndices)
+		i = static_cast<uint32_t>(rng() % count);
+	sortedIndices = randomIndices;
+	std::sort(sortedIndices.begin(), sortedIndices.end());
+
+	for (auto *indices : { &sortedIndices, &randomIndices })
+	{
+		const char *order = indices == &sortedIndices ? "sorted" : "random";
+		char name[128];
+		utl::inline_executor serial;
+		double rowByRow = bench::best_time_ns(5, [&] { bench::do_not_optimize(gather_push_back(src, *indices)); });
+		double serialGather = bench::best_time_ns(5, [&] { bench::do_not_optimize(utl::gather(src, *indices, serial)); });
+		double pooledGather = bench::best_time_ns(5, [&] { bench::do_not_optimize(utl::gather(src, *indices)); });
+		snprintf(name, sizeof(name), "gather <int,double,64B> %s, push_back", order); bench::report(name, numIndices, rowByRow);
+		snprintf(name, sizeof(name), "gather <int,double,64B> %s, serial", order); bench::report(name, numIndices, serialGather, rowByRow);
+		snprintf(name, sizeof(name), "gather <int,double,64B> %s, pool", order); bench::report(name, numIndices, pooledGather, rowByRow);
+
+		std::vector<int> ints(numIndices);
+		std::vector<double> doubles(numIndices);
+		std::vector<payload> payloads(numIndices);
+		double intLoop = bench_slice(src.slice<0>().data(), ints.data(), *indices, [](auto... args) { utl::detail::gather_slice_scalar<false>(args...); });
+		double intFast = bench_slice(src.slice<0>().data(), ints.data(), *indices, [&](auto *to, auto *from, auto *idx, size_t n) { utl::detail::gather_slice(to, from, count, idx, n); });
+		double doubleLoop = bench_slice(src.slice<1>().data(), doubles.data(), *indices, [](auto... args) { utl::detail::gather_slice_scalar<false>(args...); });
+		double doubleFast = bench_slice(src.slice<1>().data(), doubles.data(), *indices, [&](auto *to, auto *from, auto *idx, size_t n) { utl::detail::gather_slice(to, from, count, idx, n); });
+		double payloadLoop = bench_slice(src.slice<2>().data(), payloads.data(), *indices, [](auto... args) { utl::detail::gather_slice_scalar<false>(args...); });
+		double payloadPrefetch = bench_slice(src.slice<2>().data(), payloads.data(), *indices, [](auto... args) { utl::detail::gather_slice_scalar<true>(args...); });
+		snprintf(name, sizeof(name), "slice<int> %s, loop", order); bench::report(name, numIndices, intLoop);
+		snprintf(name, sizeof(name), "slice<int> %s, hardware gather", order); bench::report(name, numIndices, intFast, intLoop);
+		snprintf(name, sizeof(name), "slice<double> %s, loop", order); bench::report(name, numIndices, doubleLoop);
+		snprintf(name, sizeof(name), "slice<double> %s, hardware gather", order); bench::report(name, numIndices, doubleFast, doubleLoop);
+		snprintf(name, sizeof(name), "slice<64B> %s, loop", order); bench::report(name, numIndices, payloadLoop);
+		snprintf(name, sizeof(name), "slice<64B> %s, prefetch", order); bench::report(name, numIndices, payloadPrefetch, payloadLoop);
+
+		auto gathered = utl::gather(src, *indices);
+		double scatterSerial = bench::best_time_ns(5, [&] { utl::scatter(src, *indices, gathered, serial); });
+		double scatterPooled = bench::best_time_ns(5, [&] { utl::scatter(src, *indices, gathered); });
+		snprintf(name, sizeof(name), "scatter <int,double,64B> %s, serial", order); bench::report(name, numIndices, scatterSerial);
+		snprintf(name, sizeof(name), "scatter <int,double,64B> %s, pool", order); bench::report(name, numIndices, scatterPooled, scatterSerial);
+	}
+	return 0;
+}
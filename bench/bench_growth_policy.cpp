@@ -0,0 +1,83 @@
+#include "bench_common.h"
+#include "../huge_page_traits.h"
+#include "../parallel_vector.h"
+
+#include <stdlib.h>
+#if defined(__unix__)
+#include <sys/resource.h>
+#endif
+
+/* Growth policies: time & minor page faults of filling a vector with push_back, and capacity retained after a size spike
+ * (grow to N rows, then erase all but 1%) without shrinking, with auto-shrink and with explicit shrink_to_fit. */
+struct slow_growth_traits : utl::default_parallel_vector_traits
+{
+	static constexpr double growth_factor = 1.5;
+	static const constexpr size_t capacity_rounding = 4096;
+};
+
+struct auto_shrink_traits : utl::default_parallel_vector_traits
+{
+	static const constexpr size_t auto_shrink_divisor = 4;
+};
+
+template<typename Traits>
+using vec_type = utl::detail::parallel_vector_impl<utl::detail::type_list<int, float, double>, Traits>;
+
+static long minor_faults()
+{
+#if defined(__unix__)
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_minflt;
+#else
+	return 0;
+#endif
+}
+
+template<typename Vec>
+double bench_fill(const char *name, size_t count, double baselineNs)
+{
+	long faults = 0;
+	double ns = bench::best_time_ns(3, [&] {
+		long before = minor_faults();
+		Vec vec;
+		for (size_t i = 0; i < count; ++i)
+			vec.push_back(int(i), float(i), double(i));
+		faults = minor_faults() - before;
+		bench::do_not_optimize(vec.size());
+	});
+	bench::report(name, count, ns, baselineNs);
+	printf("    minor page faults: %ld\n", faults);
+	return ns;
+}
+
+template<typename Vec>
+void bench_spike(const char *name, size_t count, bool shrinkToFit)
+{
+	Vec vec;
+	for (size_t i = 0; i < count; ++i)
+		vec.push_back(int(i), float(i), double(i));
+	double ns = bench::best_time_ns(1, [&] {
+		// erase in steps, as a draining queue would
+		while (vec.size() > count / 100)
+			vec.erase(static_cast<uint32_t>(vec.size() - std::min<size_t>(vec.size() - count / 100, count / 20)), vec.size());
+		if (shrinkToFit)
+			vec.shrink_to_fit();
+	});
+	bench::report(name, count, ns);
+	printf("    retained capacity: %zu rows, %.1f MB\n", size_t(vec.capacity()), vec.capacity() * 16.0 * 1e-6);
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+
+	double base = bench_fill<vec_type<utl::default_parallel_vector_traits>>("push_back default growth (2x)", count, 0);
+	bench_fill<vec_type<slow_growth_traits>>("push_back 1.5x growth + page rounding", count, base);
+	bench_fill<utl::huge_page_parallel_vector<int, float, double>>("push_back huge pages + 2MB rounding", count, base);
+
+	bench_spike<vec_type<utl::default_parallel_vector_traits>>("spike drain, no shrink", count, false);
+	bench_spike<vec_type<auto_shrink_traits>>("spike drain, auto-shrink (1/4)", count, false);
+	bench_spike<vec_type<utl::default_parallel_vector_traits>>("spike drain + shrink_to_fit", count, true);
+	return 0;
+}
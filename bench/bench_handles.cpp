@@ -0,0 +1,106 @@
+#include "bench_common.h"
+#include "../handle_parallel_vector.h"
+
+#include <algorithm>
+#include <random>
+#include <stdlib.h>
+#include <unordered_map>
+#include <vector>
+
+/* Hand-rolled stable ids: dense parallel vector plus id -> row hash map and row -> id column, patched on swap-remove. */
+struct hashed_ids
+{
+	utl::parallel_vector<float, float, uint32_t> rows;	// x, y, id
+	std::unordered_map<uint32_t, uint32_t> idToRow;
+	uint32_t nextId = 0;
+
+	uint32_t insert(float x, float y)
+	{
+		uint32_t id = nextId++;
+		idToRow[id] = rows.size();
+		rows.push_back(x, y, id);
+		return id;
+	}
+
+	void erase(uint32_t id)
+	{
+		auto it = idToRow.find(id);
+		uint32_t row = it->second;
+		idToRow.erase(it);
+		uint32_t last = rows.size() - 1;
+		if (row != last)
+			idToRow[rows.slice<2>()[last]] = row;
+		rows.swap_remove(row);
+	}
+
+	float &x(uint32_t id) { return rows.slice<0>()[idToRow.find(id)->second]; }
+};
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+	std::mt19937 rng(42);
+
+	using handle_vec = utl::handle_parallel_vector<float, float>;
+	handle_vec handles;
+	std::vector<handle_vec::handle> issued;
+	hashed_ids hashed;
+	std::vector<uint32_t> ids;
+
+	double hashedInsert = bench::best_time_ns(5, [&] { hashed = hashed_ids(); ids.clear(); }, [&] {
+		for (size_t i = 0; i < count; ++i)
+			ids.push_back(hashed.insert(float(i), 0.0f));
+	});
+	double handleInsert = bench::best_time_ns(5, [&] { handles = handle_vec(); issued.clear(); }, [&] {
+		for (size_t i = 0; i < count; ++i)
+			issued.push_back(handles.insert(float(i), 0.0f));
+	});
+	bench::report("insert, hash map ids", count, hashedInsert);
+	bench::report("insert, generational handles", count, handleInsert, hashedInsert);
+
+	// random lookups
+	std::vector<size_t> order(count);
+	for (size_t i = 0; i < count; ++i)
+		order[i] = i;
+	std::shuffle(order.begin(), order.end(), rng);
+	double hashedLookup = bench::best_time_ns(5, [&] {
+		for (size_t i : order)
+			hashed.x(ids[i]) += 1.0f;
+	});
+	double handleLookup = bench::best_time_ns(5, [&] {
+		for (size_t i : order)
+			handles.get<0>(issued[i]) += 1.0f;
+	});
+	bench::report("random lookup, hash map ids", count, hashedLookup);
+	bench::report("random lookup, generational handles", count, handleLookup, hashedLookup);
+
+	// remove half in random order
+	size_t numRemoved = count / 2;
+	double hashedErase = bench::best_time_ns(1, [&] {
+		for (size_t i = 0; i < numRemoved; ++i)
+			hashed.erase(ids[order[i]]);
+	});
+	double handleErase = bench::best_time_ns(1, [&] {
+		for (size_t i = 0; i < numRemoved; ++i)
+			handles.erase(issued[order[i]]);
+	});
+	bench::report("random remove, hash map ids", numRemoved, hashedErase);
+	bench::report("random remove, generational handles", numRemoved, handleErase, hashedErase);
+
+	// dense iteration is identical for both: packed slices
+	double hashedScan = bench::best_time_ns(5, [&] {
+		float sum = 0;
+		for (float x : hashed.rows.slice<0>())
+			sum += x;
+		bench::do_not_optimize(sum);
+	});
+	double handleScan = bench::best_time_ns(5, [&] {
+		float sum = 0;
+		for (float x : handles.slice<0>())
+			sum += x;
+		bench::do_not_optimize(sum);
+	});
+	bench::report("scan survivors, hash map ids", handles.size(), hashedScan);
+	bench::report("scan survivors, generational handles", handles.size(), handleScan, hashedScan);
+	return 0;
+}
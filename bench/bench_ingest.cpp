@@ -0,0 +1,61 @@
+#include "bench_common.h"
+#include "../parallel_vector.h"
+
+#include <stdlib.h>
+#include <vector>
+
+/* Ingestion of data arriving column by column in batches: per-row push_back vs bulk column append vs uninitialized resize + direct fill. */
+using vec_type = utl::parallel_vector<int, float, double, uint16_t>;
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+	const size_t kBatchSize = 65536;
+
+	std::vector<int> c0(kBatchSize);
+	std::vector<float> c1(kBatchSize);
+	std::vector<double> c2(kBatchSize);
+	std::vector<uint16_t> c3(kBatchSize);
+	for (size_t i = 0; i < kBatchSize; ++i)
+	{
+		c0[i] = int(i);
+		c1[i] = float(i);
+		c2[i] = double(i);
+		c3[i] = uint16_t(i);
+	}
+
+	// capacity is reserved upfront and kept between runs, so that only ingestion itself is measured (not page faults or growth)
+	vec_type vec(static_cast<uint32_t>(count));
+	double pushBack = bench::best_time_ns(5, [&] { vec.clear(); }, [&] {
+		for (size_t done = 0; done < count; done += kBatchSize)
+			for (size_t i = 0, n = std::min(kBatchSize, count - done); i < n; ++i)
+				vec.push_back(c0[i], c1[i], c2[i], c3[i]);
+	});
+	double append = bench::best_time_ns(5, [&] { vec.clear(); }, [&] {
+		for (size_t done = 0; done < count; done += kBatchSize)
+		{
+			size_t n = std::min(kBatchSize, count - done);
+			vec.append_columns(utl::make_array_view(c0.data(), n), utl::make_array_view(c1.data(), n), utl::make_array_view(c2.data(), n), utl::make_array_view(c3.data(), n));
+		}
+	});
+	double resizeFill = bench::best_time_ns(5, [&] { vec.clear(); }, [&] {
+		// producer writes directly into slices, e.g. decoding a file format
+		for (size_t done = 0; done < count; done += kBatchSize)
+		{
+			size_t n = std::min(kBatchSize, count - done);
+			vec.resize_default_init(static_cast<uint32_t>(done + n));
+			auto s0 = vec.slice<0>(); auto s1 = vec.slice<1>(); auto s2 = vec.slice<2>(); auto s3 = vec.slice<3>();
+			for (size_t i = 0; i < n; ++i)
+			{
+				s0[done + i] = int(i);
+				s1[done + i] = float(i);
+				s2[done + i] = double(i);
+				s3[done + i] = uint16_t(i);
+			}
+		}
+	});
+	bench::report("ingest per-row push_back", count, pushBack);
+	bench::report("ingest append_columns", count, append, pushBack);
+	bench::report("ingest resize_default_init + fill", count, resizeFill, pushBack);
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include "bench_common.h"
+#include "../parallel_vector.h"
+#include "../parallel_vector_sort.h"
+
+#include <algorithm>
+#include <stdlib.h>
+
+/* Row-wise computation over three slices: out = a * b + out. Hand-written index loop is the baseline; view-based loops should compile
+ * to the same code (indexed loads from each slice base, vectorized at -O3). Inspect codegen of loop_* functions with e.g. objdump -d -C. */
+using vec_type = utl::parallel_vector<float, float, float, int>;
+
+BENCH_NOINLINE void loop_indexed(vec_type &vec)
+{
+	auto a = vec.slice<0>();
+	auto b = vec.slice<1>();
+	auto out = vec.slice<2>();
+	for (size_t i = 0; i < out.size(); ++i)
+		out[i] = a[i] * b[i] + out[i];
+}
+
+BENCH_NOINLINE void loop_view_range_for(vec_type &vec)
+{
+	for (auto [a, b, out] : vec.view<0, 1, 2>())
+		out = a * b + out;
+}
+
+BENCH_NOINLINE void loop_view_for_each(vec_type &vec)
+{
+	auto view = vec.view<0, 1, 2>();
+	std::for_each(view.begin(), view.end(), [](auto row) { std::get<2>(row) = std::get<0>(row) * std::get<1>(row) + std::get<2>(row); });
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+
+	vec_type vec(static_cast<uint32_t>(count));
+	uint32_t seed = 12345;
+	for (size_t i = 0; i < count; ++i)
+	{
+		seed = seed * 1664525 + 1013904223;
+		vec.push_back(float(i & 1023), 0.5f, 0.0f, int(seed >> 8));
+	}
+
+	double indexed = bench::best_time_ns(10, [&] { loop_indexed(vec); bench::do_not_optimize(vec.slice<2>()[0]); });
+	double rangeFor = bench::best_time_ns(10, [&] { loop_view_range_for(vec); bench::do_not_optimize(vec.slice<2>()[0]); });
+	double forEach = bench::best_time_ns(10, [&] { loop_view_for_each(vec); bench::do_not_optimize(vec.slice<2>()[0]); });
+	bench::report("a*b+c hand-written index loop", count, indexed);
+	bench::report("a*b+c view range-for", count, rangeFor, indexed);
+	bench::report("a*b+c view std::for_each", count, forEach, indexed);
+
+	// sorting all slices by key: std::sort on the view swaps rows in place, sort_by computes permutation and gathers
+	vec_type copy = vec;
+	double viewSort = bench::best_time_ns(3, [&] { copy = vec; }, [&] {
+		auto view = copy.view();
+		std::sort(view.begin(), view.end(), [](const auto &l, const auto &r) { return std::get<3>(l) < std::get<3>(r); });
+	});
+	double sortBy = bench::best_time_ns(3, [&] { copy = vec; }, [&] { utl::sort_by<3>(copy); });
+	bench::report("sort by int key, std::sort on view", count, viewSort);
+	bench::report("sort by int key, sort_by", count, sortBy, viewSort);
+	return 0;
+}
@@ -0,0 +1,66 @@
+#include "bench_common.h"
+#include "../snapshot_parallel_vector.h"
+
+#include <stdlib.h>
+
+/* Cost for the writer of making a consistent version available to readers after each simulation tick:
+ * full copy of a regular parallel vector vs publication with per-slice copy-on-write. */
+using plain_type = utl::parallel_vector<float, float, float, int>;
+using published_type = utl::snapshot_parallel_vector<float, float, float, int>;
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+	const size_t kAppends = 1000;
+
+	plain_type plain;
+	published_type published;
+	plain.reserve(static_cast<plain_type::size_type>(count + 100 * kAppends));
+	published.reserve(static_cast<published_type::size_type>(count + 100 * kAppends));
+	for (size_t i = 0; i < count; ++i)
+	{
+		plain.push_back(float(i), 0.0f, 0.0f, int(i));
+		published.push_back(float(i), 0.0f, 0.0f, int(i));
+	}
+	published.publish();
+
+	// readers hold on to previous version, so every tick that modifies published rows has to copy
+	plain_type plainSnapshot;
+	published_type::snapshot_type heldSnapshot;
+
+	double copyAll = bench::best_time_ns(10, [&] {
+		for (auto &x : plain.slice<0>())
+			x += 1.0f;
+	}, [&] { plainSnapshot = plain; });
+	double publishOne = bench::best_time_ns(10, [&] { heldSnapshot = published.snapshot(); }, [&] {
+		for (auto &x : published.write_slice<0>())
+			x += 1.0f;
+		published.publish();
+	});
+	double updateOnly = bench::best_time_ns(10, [&] {
+		for (auto &x : plain.slice<0>())
+			x += 1.0f;
+	});
+	bench::report("tick: update 1 of 4 slices, then full copy", count, copyAll + updateOnly);
+	bench::report("tick: update 1 of 4 slices, then publish", count, publishOne, copyAll + updateOnly);
+
+	double copyAfterAppend = bench::best_time_ns(10, [&] {
+		for (size_t i = 0; i < kAppends; ++i)
+			plain.push_back(0.0f, 0.0f, 0.0f, int(i));
+	}, [&] { plainSnapshot = plain; });
+	double publishAfterAppend = bench::best_time_ns(10, [&] { heldSnapshot = published.snapshot(); }, [&] {
+		for (size_t i = 0; i < kAppends; ++i)
+			published.push_back(0.0f, 0.0f, 0.0f, int(i));
+		published.publish();
+	});
+	bench::report("tick: append 1000 rows, then full copy", count, copyAfterAppend);
+	bench::report("tick: append 1000 rows, then publish", count, publishAfterAppend, copyAfterAppend);
+
+	const size_t kAcquires = 100000;
+	double acquire = bench::best_time_ns(5, [&] {
+		for (size_t i = 0; i < kAcquires; ++i)
+			bench::do_not_optimize(published.snapshot().size());
+	});
+	bench::report("reader: take and drop snapshot", kAcquires, acquire);
+	return 0;
+}
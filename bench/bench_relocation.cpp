@@ -0,0 +1,219 @@
+#include "bench_common.h"
+#include "../parallel_vector.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdlib.h>
+#include <vector>
+
+/* Wrapper that behaves exactly like T, but has user-provided copy/move, so it is not trivially copyable and goes through element-wise paths. */
+template<typename T>
+struct non_trivial
+{
+	T value;
+
+	non_trivial(T v = T()) : value(v) {}
+	non_trivial(const non_trivial &rhs) : value(rhs.value) {}
+	non_trivial(non_trivial &&rhs) noexcept : value(rhs.value) {}
+	non_trivial &operator=(const non_trivial &rhs) { value = rhs.value; return *this; }
+	non_trivial &operator=(non_trivial &&rhs) noexcept { value = rhs.value; return *this; }
+};
+
+/* Owning pointer wrapper: not trivially copyable, but safe to relocate bytewise, so it opts in explicitly. */
+struct owned_int
+{
+	std::unique_ptr<int> ptr;
+};
+
+struct owned_int_slow
+{
+	std::unique_ptr<int> ptr;
+};
+
+namespace utl {
+template<> struct is_trivially_relocatable<owned_int> : std::true_type {};
+}
+
+template<typename Vec, typename... Args>
+void fill(Vec &vec, size_t count, Args... args)
+{
+	for (size_t i = 0; i < count; ++i)
+		vec.push_back(args...);
+}
+
+/* Growth: reserve larger block for already filled vector (single reallocation, all elements relocated). */
+template<typename Vec, typename... Args>
+double bench_growth(size_t count, Args... args)
+{
+	Vec vec;
+	return bench::best_time_ns(5, [&] {
+		vec = Vec();
+		fill(vec, count, args...);
+	}, [&] {
+		vec.reserve(2 * vec.capacity() + 1);
+	});
+}
+
+/* Mid-vector erase: remove several rows from the middle, shifting half of the vector each time. */
+template<typename Vec, typename... Args>
+double bench_erase(size_t count, size_t numErases, Args... args)
+{
+	Vec vec;
+	return bench::best_time_ns(5, [&] {
+		vec = Vec();
+		vec.reserve(count);
+		fill(vec, count, args...);
+	}, [&] {
+		for (size_t i = 0; i < numErases; ++i)
+			vec.erase(vec.size() / 2, vec.size() / 2 + 1);
+	});
+}
+
+/* Mid-vector insert: insert single rows into the middle of vector with spare capacity. */
+template<typename Vec, typename... Args>
+double bench_insert(size_t count, size_t numInserts, Args... args)
+{
+	Vec vec, row;
+	fill(row, 1, args...);
+	return bench::best_time_ns(5, [&] {
+		vec = Vec();
+		vec.reserve(count + numInserts);
+		fill(vec, count, args...);
+	}, [&] {
+		for (size_t i = 0; i < numInserts; ++i)
+			vec.insert_copy(vec.size() / 2, row, 0, 1);
+	});
+}
+
+/* Mid-vector insert into full vector: single-pass reallocating insert vs explicit reserve followed by insert (tail moved twice). */
+template<typename Vec, typename... Args>
+double bench_insert_full(size_t count, bool reserveFirst, Args... args)
+{
+	Vec vec, row;
+	fill(row, 1, args...);
+	return bench::best_time_ns(5, [&] {
+		vec = Vec();
+		vec.reserve(count);
+		fill(vec, vec.capacity(), args...);
+	}, [&] {
+		if (reserveFirst)
+			vec.reserve(vec.size() + 1);
+		vec.insert_copy(vec.size() / 2, row, 0, 1);
+	});
+}
+
+enum class removal { erase_each, erase_mask, swap_remove, unordered_erase };
+
+/* Scattered removal: remove random rows (given in descending order) one by one with order-preserving erase, with single compacting pass,
+ * one by one with swap_remove, or with batched unordered_erase. */
+template<typename Vec, typename... Args>
+double bench_removal(size_t count, const std::vector<size_t> &indices, removal mode, Args... args)
+{
+	Vec vec;
+	std::vector<bool> mask;
+	return bench::best_time_ns(5, [&] {
+		vec = Vec();
+		vec.reserve(count);
+		fill(vec, count, args...);
+	}, [&] {
+		switch (mode)
+		{
+		case removal::erase_each:
+			for (size_t i : indices)
+				vec.erase(i, i + 1);
+			break;
+		case removal::erase_mask:
+			mask.assign(count, false);
+			for (size_t i : indices)
+				mask[i] = true;
+			vec.erase_mask(mask);
+			break;
+		case removal::swap_remove:
+			for (size_t i : indices)
+				vec.swap_remove(i);
+			break;
+		case removal::unordered_erase:
+			bench::do_not_optimize(vec.unordered_erase(indices));
+			break;
+		}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+	const size_t kNumShifts = 16;
+
+	using fast_vec = utl::parallel_vector<int, float, double>;
+	using slow_vec = utl::parallel_vector<non_trivial<int>, non_trivial<float>, non_trivial<double>>;
+
+	double slowGrowth = bench_growth<slow_vec>(count, 1, 2.0f, 3.0);
+	double fastGrowth = bench_growth<fast_vec>(count, 1, 2.0f, 3.0);
+	bench::report("reserve growth <int,float,double> element-wise", count, slowGrowth);
+	bench::report("reserve growth <int,float,double> memcpy", count, fastGrowth, slowGrowth);
+
+	double slowErase = bench_erase<slow_vec>(count, kNumShifts, 1, 2.0f, 3.0);
+	double fastErase = bench_erase<fast_vec>(count, kNumShifts, 1, 2.0f, 3.0);
+	bench::report("mid erase <int,float,double> element-wise", kNumShifts * count / 2, slowErase);
+	bench::report("mid erase <int,float,double> memmove", kNumShifts * count / 2, fastErase, slowErase);
+
+	double slowInsert = bench_insert<slow_vec>(count, kNumShifts, 1, 2.0f, 3.0);
+	double fastInsert = bench_insert<fast_vec>(count, kNumShifts, 1, 2.0f, 3.0);
+	bench::report("mid insert <int,float,double> element-wise", kNumShifts * count / 2, slowInsert);
+	bench::report("mid insert <int,float,double> memmove", kNumShifts * count / 2, fastInsert, slowInsert);
+
+	double slowTwoPass = bench_insert_full<slow_vec>(count, true, 1, 2.0f, 3.0);
+	double slowOnePass = bench_insert_full<slow_vec>(count, false, 1, 2.0f, 3.0);
+	double fastTwoPass = bench_insert_full<fast_vec>(count, true, 1, 2.0f, 3.0);
+	double fastOnePass = bench_insert_full<fast_vec>(count, false, 1, 2.0f, 3.0);
+	bench::report("full insert element-wise, reserve + insert", count, slowTwoPass);
+	bench::report("full insert element-wise, single pass", count, slowOnePass, slowTwoPass);
+	bench::report("full insert memcpy, reserve + insert", count, fastTwoPass);
+	bench::report("full insert memcpy, single pass", count, fastOnePass, fastTwoPass);
+
+	const size_t kNumRemovals = 256;
+	std::vector<size_t> removed(count);
+	for (size_t i = 0; i < count; ++i)
+		removed[i] = i;
+	std::shuffle(removed.begin(), removed.end(), std::mt19937(42));
+	removed.resize(std::min(kNumRemovals, count));
+	std::sort(removed.begin(), removed.end(), std::greater<size_t>());
+	auto report_removal = [&](auto bench_fn, const char *typeName) {
+		char name[128];
+		double eraseEach = bench_fn(removal::erase_each);
+		double eraseMask = bench_fn(removal::erase_mask);
+		double swapRemove = bench_fn(removal::swap_remove);
+		double unorderedErase = bench_fn(removal::unordered_erase);
+		snprintf(name, sizeof(name), "remove %zu rows %s, erase each", removed.size(), typeName);
+		bench::report(name, removed.size(), eraseEach);
+		snprintf(name, sizeof(name), "remove %zu rows %s, erase_mask", removed.size(), typeName);
+		bench::report(name, removed.size(), eraseMask, eraseEach);
+		snprintf(name, sizeof(name), "remove %zu rows %s, swap_remove", removed.size(), typeName);
+		bench::report(name, removed.size(), swapRemove, eraseEach);
+		snprintf(name, sizeof(name), "remove %zu rows %s, unordered_erase", removed.size(), typeName);
+		bench::report(name, removed.size(), unorderedErase, eraseEach);
+	};
+	report_removal([&](removal mode) { return bench_removal<fast_vec>(count, removed, mode, 1, 2.0f, 3.0); }, "memcpy");
+	report_removal([&](removal mode) { return bench_removal<slow_vec>(count, removed, mode, 1, 2.0f, 3.0); }, "element-wise");
+
+	// opted-in relocatable type: growth relocates bytewise instead of move + destroy
+	size_t ownedCount = count / 4;
+	using owned_vec = utl::parallel_vector<owned_int, int>;
+	using owned_slow_vec = utl::parallel_vector<owned_int_slow, int>;
+	double slowOwned = bench::best_time_ns(5, [&] {
+		owned_slow_vec vec;
+		for (size_t i = 0; i < ownedCount; ++i)
+			vec.push_back(std::forward_as_tuple(), int(i));
+	});
+	double fastOwned = bench::best_time_ns(5, [&] {
+		owned_vec vec;
+		for (size_t i = 0; i < ownedCount; ++i)
+			vec.push_back(std::forward_as_tuple(), int(i));
+	});
+	bench::report("push_back <unique_ptr,int> element-wise", ownedCount, slowOwned);
+	bench::report("push_back <unique_ptr,int> opted-in relocation", ownedCount, fastOwned, slowOwned);
+
+	return 0;
+}
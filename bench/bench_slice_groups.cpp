@@ -0,0 +1,88 @@
+#include "bench_common.h"
+#include "../parallel_vector.h"
+#include "../strong_typedef.h"
+
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+/* Hot/cold split: integrate positions with velocities (6 hot floats per row), while rows also carry cold name & flags.
+ * Compares fully columnar layout, grouped hot fields (position and velocity interleaved in two slices) and array of structures. */
+STRONG_TYPEDEF(pos_x, float);
+STRONG_TYPEDEF(pos_y, float);
+STRONG_TYPEDEF(pos_z, float);
+STRONG_TYPEDEF(vel_x, float);
+STRONG_TYPEDEF(vel_y, float);
+STRONG_TYPEDEF(vel_z, float);
+
+using columnar_vec = utl::parallel_vector<float, float, float, float, float, float, std::string, uint8_t>;
+using grouped_vec = utl::parallel_vector<utl::group<pos_x, pos_y, pos_z>, utl::group<vel_x, vel_y, vel_z>, std::string, uint8_t>;
+
+struct entity
+{
+	float px, py, pz, vx, vy, vz;
+	std::string name;
+	uint8_t flags;
+};
+
+BENCH_NOINLINE void update_columnar(columnar_vec &vec, float dt)
+{
+	auto px = vec.slice<0>(); auto py = vec.slice<1>(); auto pz = vec.slice<2>();
+	auto vx = vec.slice<3>(); auto vy = vec.slice<4>(); auto vz = vec.slice<5>();
+	for (size_t i = 0; i < vec.size(); ++i)
+	{
+		px[i] += vx[i] * dt;
+		py[i] += vy[i] * dt;
+		pz[i] += vz[i] * dt;
+	}
+}
+
+BENCH_NOINLINE void update_grouped(grouped_vec &vec, float dt)
+{
+	auto pos = vec.slice<0>();
+	auto vel = vec.slice<1>();
+	for (size_t i = 0; i < vec.size(); ++i)
+	{
+		auto &[px, py, pz] = pos[i];
+		auto &[vx, vy, vz] = vel[i];
+		px = pos_x(px + vx * dt);
+		py = pos_y(py + vy * dt);
+		pz = pos_z(pz + vz * dt);
+	}
+}
+
+BENCH_NOINLINE void update_aos(std::vector<entity> &vec, float dt)
+{
+	for (auto &e : vec)
+	{
+		e.px += e.vx * dt;
+		e.py += e.vy * dt;
+		e.pz += e.vz * dt;
+	}
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : (1 << 22);
+	const float kDt = 0.01f;
+
+	columnar_vec columnar(static_cast<uint32_t>(count));
+	grouped_vec grouped(static_cast<uint32_t>(count));
+	std::vector<entity> aos;
+	aos.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		float f = float(i & 1023);
+		columnar.push_back(f, f, f, 1.0f, 2.0f, 3.0f, std::string(), uint8_t(0));
+		grouped.push_back(std::make_tuple(f, f, f), std::make_tuple(1.0f, 2.0f, 3.0f), std::string(), uint8_t(0));
+		aos.push_back({ f, f, f, 1.0f, 2.0f, 3.0f, std::string(), uint8_t(0) });
+	}
+
+	double columnarTime = bench::best_time_ns(10, [&] { update_columnar(columnar, kDt); bench::do_not_optimize(columnar.slice<0>()[0]); });
+	double groupedTime = bench::best_time_ns(10, [&] { update_grouped(grouped, kDt); bench::do_not_optimize(grouped.slice<0>()[0]); });
+	double aosTime = bench::best_time_ns(10, [&] { update_aos(aos, kDt); bench::do_not_optimize(aos[0].px); });
+	bench::report("integrate columnar (6 float slices)", count, columnarTime);
+	bench::report("integrate grouped (pos & vel groups)", count, groupedTime, columnarTime);
+	bench::report("integrate std::vector<struct> with cold fields", count, aosTime, columnarTime);
+	return 0;
+}
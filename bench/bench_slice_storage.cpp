@@ -0,0 +1,63 @@
+#include "bench_common.h"
+#include "../huge_page_traits.h"
+#include "../parallel_vector.h"
+
+#include <stdlib.h>
+
+/* Append-heavy workload: push_back rows into empty vector, growing it by repeated reallocation. */
+template<typename Vec>
+double bench_append(size_t count)
+{
+	return bench::best_time_ns(5, [&] {
+		Vec vec;
+		for (size_t i = 0; i < count; ++i)
+			vec.push_back(int(i), float(i), float(i), float(i), float(i), double(i));
+		bench::do_not_optimize(vec.size());
+	});
+}
+
+/* Scan-heavy workload: row-wise computation touching all slices with same index, then reading result. Vector capacity is power-of-two,
+ * which is the worst case for the single block layout (all slices are the same number of pages apart). */
+template<typename Vec>
+double bench_scan(size_t count)
+{
+	Vec vec(static_cast<typename Vec::size_type>(count));
+	for (size_t i = 0; i < count; ++i)
+		vec.push_back(int(i), float(i), float(i + 1), float(i + 2), float(i + 3), 0.0);
+
+	auto a = vec.template slice<1>();
+	auto b = vec.template slice<2>();
+	auto c = vec.template slice<3>();
+	auto d = vec.template slice<4>();
+	auto out = vec.template slice<5>();
+	return bench::best_time_ns(10, [&] {
+		for (size_t i = 0; i < count; ++i)
+			out[i] = a[i] * b[i] + c[i] * d[i];
+		bench::do_not_optimize(out[count - 1]);
+	});
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : (1 << 22);
+
+	using single_vec = utl::parallel_vector<int, float, float, float, float, double>;
+	using separate_vec = utl::separate_parallel_vector<int, float, float, float, float, double>;
+	using huge_page_vec = utl::huge_page_parallel_vector<int, float, float, float, float, double>;
+
+	double singleAppend = bench_append<single_vec>(count);
+	double separateAppend = bench_append<separate_vec>(count);
+	double hugePageAppend = bench_append<huge_page_vec>(count);
+	bench::report("push_back single block", count, singleAppend);
+	bench::report("push_back separate slices (realloc)", count, separateAppend, singleAppend);
+	bench::report("push_back huge page slices (mremap)", count, hugePageAppend, singleAppend);
+
+	double singleScan = bench_scan<single_vec>(count);
+	double separateScan = bench_scan<separate_vec>(count);
+	double hugePageScan = bench_scan<huge_page_vec>(count);
+	bench::report("row scan 5 slices single block", count, singleScan);
+	bench::report("row scan 5 slices separate slices", count, separateScan, singleScan);
+	bench::report("row scan 5 slices huge page slices", count, hugePageScan, singleScan);
+
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include "bench_common.h"
+#include "../mapped_parallel_vector.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using vec_type = utl::parallel_vector<int, float, double, uint8_t>;
+
+/* Baseline: serialize row by row, as typically done with generic serialization code. */
+void save_rows(const vec_type &vec, const char *path)
+{
+	FILE *file = fopen(path, "wb");
+	uint64_t size = vec.size();
+	fwrite(&size, sizeof(size), 1, file);
+	for (size_t i = 0; i < vec.size(); ++i)
+	{
+		fwrite(&vec.slice<0>()[i], sizeof(int), 1, file);
+		fwrite(&vec.slice<1>()[i], sizeof(float), 1, file);
+		fwrite(&vec.slice<2>()[i], sizeof(double), 1, file);
+		fwrite(&vec.slice<3>()[i], sizeof(uint8_t), 1, file);
+	}
+	fclose(file);
+}
+
+void load_rows(vec_type &vec, const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	uint64_t size = 0;
+	if (fread(&size, sizeof(size), 1, file) != 1)
+		size = 0;
+	vec.clear();
+	vec.reserve(static_cast<vec_type::size_type>(size));
+	for (uint64_t i = 0; i < size; ++i)
+	{
+		int a = 0; float b = 0; double c = 0; uint8_t d = 0;
+		bool ok = fread(&a, sizeof(a), 1, file) == 1 && fread(&b, sizeof(b), 1, file) == 1 && fread(&c, sizeof(c), 1, file) == 1 && fread(&d, sizeof(d), 1, file) == 1;
+		if (!ok)
+			break;
+		vec.push_back(a, b, c, d);
+	}
+	fclose(file);
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+	const char *rowsPath = argc > 2 ? argv[2] : "bench_snapshot_rows.bin";
+	const char *snapshotPath = argc > 3 ? argv[3] : "bench_snapshot.bin";
+
+	vec_type vec;
+	for (size_t i = 0; i < count; ++i)
+		vec.push_back(int(i), float(i), double(i), uint8_t(i));
+
+	double rowsSave = bench::best_time_ns(3, [&] { save_rows(vec, rowsPath); });
+	double snapshotSave = bench::best_time_ns(3, [&] { utl::save_snapshot(vec, snapshotPath); });
+	bench::report("save row by row", count, rowsSave);
+	bench::report("save snapshot", count, snapshotSave, rowsSave);
+
+	vec_type loaded;
+	double rowsLoad = bench::best_time_ns(3, [&] { load_rows(loaded, rowsPath); });
+	double snapshotLoad = bench::best_time_ns(3, [&] { utl::load_snapshot(loaded, snapshotPath); });
+	double mappedOpen = bench::best_time_ns(3, [&] {
+		utl::mapped_parallel_vector<int, float, double, uint8_t> mapped(snapshotPath);
+		bench::do_not_optimize(mapped.slice<2>()[count / 2]);
+	});
+	bench::report("load row by row", count, rowsLoad);
+	bench::report("load snapshot into vector", count, snapshotLoad, rowsLoad);
+	bench::report("open mapped snapshot", count, mappedOpen, rowsLoad);
+
+	remove(rowsPath);
+	remove(snapshotPath);
+	return 0;
+}
@@ -0,0 +1,58 @@
+#include "bench_common.h"
+#include "../arena_traits.h"
+
+#include <stdlib.h>
+#include <vector>
+
+/* Temp-vector churn: every frame creates many short-lived query result vectors of varying size, fills them by push_back and drops them.
+ * Vectors either grow from empty (several reallocations each) or reserve exact size upfront (single allocation each). */
+template<typename MakeVec, typename EndFrame>
+double bench_churn(size_t numFrames, size_t numVectors, const std::vector<uint32_t> &sizes, bool reserve, MakeVec &&makeVec, EndFrame &&endFrame)
+{
+	return bench::best_time_ns(5, [&] {
+		for (size_t frame = 0; frame < numFrames; ++frame)
+		{
+			for (size_t v = 0; v < numVectors; ++v)
+			{
+				auto vec = makeVec();
+				uint32_t count = sizes[(frame * numVectors + v) % sizes.size()];
+				if (reserve)
+					vec.reserve(count);
+				for (uint32_t i = 0; i < count; ++i)
+					vec.push_back(int(i), float(i), uint16_t(i));
+				bench::do_not_optimize(vec.size());
+			}
+			endFrame();
+		}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	size_t numFrames = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100;
+	const size_t kNumVectors = 1000;
+
+	// mostly small results with occasional large ones
+	std::vector<uint32_t> sizes(4096);
+	uint32_t seed = 12345;
+	for (auto &s : sizes)
+	{
+		seed = seed * 1664525 + 1013904223;
+		s = (seed >> 8) % 16 == 0 ? (seed >> 12) % 4000 : (seed >> 12) % 100;
+	}
+
+	size_t numOps = numFrames * kNumVectors;
+	utl::monotonic_arena arena;
+	utl::size_class_pool pool;
+	for (bool reserve : { false, true })
+	{
+		double heap = bench_churn(numFrames, kNumVectors, sizes, reserve, [] { return utl::parallel_vector<int, float, uint16_t>(); }, [] {});
+		double arenaTime = bench_churn(numFrames, kNumVectors, sizes, reserve, [&] { return utl::arena_parallel_vector<int, float, uint16_t>(arena); }, [&] { arena.reset(); });
+		double poolTime = bench_churn(numFrames, kNumVectors, sizes, reserve, [&] { return utl::pool_parallel_vector<int, float, uint16_t>(pool); }, [] {});
+
+		bench::report(reserve ? "temp vectors reserved, global heap" : "temp vectors grown, global heap", numOps, heap);
+		bench::report(reserve ? "temp vectors reserved, monotonic arena" : "temp vectors grown, monotonic arena", numOps, arenaTime, heap);
+		bench::report(reserve ? "temp vectors reserved, size-class pool" : "temp vectors grown, size-class pool", numOps, poolTime, heap);
+	}
+	return 0;
+}
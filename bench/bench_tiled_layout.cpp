@@ -0,0 +1,51 @@
+#include "bench_common.h"
+#include "../parallel_vector.h"
+#include "../tiled_parallel_vector.h"
+
+#include <stdlib.h>
+
+/* Multi-column kernel out = a * b + c * d + e over 6 float fields: plain SoA parallel vector (power-of-two capacity, the worst case for aliasing)
+ * vs tiled (AoSoA) layout with 8- and 16-wide tiles processed tile by tile. */
+template<typename Vec>
+void fill(Vec &vec, size_t count)
+{
+	for (size_t i = 0; i < count; ++i)
+		vec.push_back(float(i & 255), 0.5f, float(i & 15), 2.0f, 1.0f, 0.0f);
+}
+
+BENCH_NOINLINE void kernel_soa(utl::parallel_vector<float, float, float, float, float, float> &vec)
+{
+	auto a = vec.slice<0>().data(), b = vec.slice<1>().data(), c = vec.slice<2>().data(), d = vec.slice<3>().data(), e = vec.slice<4>().data();
+	auto out = vec.slice<5>().data();
+	for (size_t i = 0, n = vec.size(); i < n; ++i)
+		out[i] = a[i] * b[i] + c[i] * d[i] + e[i];
+}
+
+template<typename Vec>
+BENCH_NOINLINE void kernel_tiled(Vec &vec)
+{
+	vec.for_each_tile([](auto a, auto b, auto c, auto d, auto e, auto out) {
+		for (size_t i = 0; i < out.size(); ++i)
+			out[i] = a[i] * b[i] + c[i] * d[i] + e[i];
+	});
+}
+
+int main(int argc, char **argv)
+{
+	size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : (1 << 22);
+
+	utl::parallel_vector<float, float, float, float, float, float> soa(static_cast<uint32_t>(count));
+	utl::tiled_parallel_vector<8, float, float, float, float, float, float> tiled8(static_cast<uint32_t>(count));
+	utl::tiled_parallel_vector<16, float, float, float, float, float, float> tiled16(static_cast<uint32_t>(count));
+	fill(soa, count);
+	fill(tiled8, count);
+	fill(tiled16, count);
+
+	double soaTime = bench::best_time_ns(10, [&] { kernel_soa(soa); bench::do_not_optimize(soa.slice<5>()[0]); });
+	double tiled8Time = bench::best_time_ns(10, [&] { kernel_tiled(tiled8); bench::do_not_optimize(tiled8.get<5>(0)); });
+	double tiled16Time = bench::best_time_ns(10, [&] { kernel_tiled(tiled16); bench::do_not_optimize(tiled16.get<5>(0)); });
+	bench::report("6-column kernel SoA", count, soaTime);
+	bench::report("6-column kernel tiled W=8", count, tiled8Time, soaTime);
+	bench::report("6-column kernel tiled W=16", count, tiled16Time, soaTime);
+	return 0;
+}
@@ -0,0 +1,63 @@
+/* Compile-time benchmark: instantiates parallel vectors with 64 slices and every per-slice operation (layout, by-index and by-type access,
+ * modifiers), so that template metaprogramming cost dominates compilation of this translation unit.
+ * Time it with clang -ftime-trace (enabled by CMake, trace is written next to the object file) or gcc -ftime-report; ctest also compiles it
+ * with a time budget to catch regressions. */
+
+#include "../parallel_vector.h"
+
+#include <stdint.h>
+#include <utility>
+
+namespace {
+
+/* 64 distinct column types of varying size and alignment. */
+template<size_t I>
+struct column
+{
+	std::conditional_t<I % 4 == 0, double, std::conditional_t<I % 4 == 1, float, std::conditional_t<I % 4 == 2, uint16_t, uint8_t>>> value[1 + I % 3];
+};
+
+template<typename Seq, template<typename...> typename Vec>
+struct make_vector;
+
+template<size_t... I, template<typename...> typename Vec>
+struct make_vector<std::index_sequence<I...>, Vec>
+{
+	using type = Vec<column<I>...>;
+};
+
+template<typename... Types>
+using separate_vector = utl::separate_parallel_vector<Types...>;
+
+template<typename Vec, size_t... I>
+size_t touch_all(Vec &vec, std::index_sequence<I...>)
+{
+	// every slice by index and by type
+	size_t result = (vec.template slice<I>().size() + ...);
+	result += (vec.template slice<column<I>>().size() + ...);
+	return result;
+}
+
+template<typename Vec>
+size_t exercise()
+{
+	Vec vec, other;
+	vec.reserve(100);
+	vec.resize(50);
+	other.resize(10);
+	vec.insert_copy(10, other, 0, 10);
+	vec.erase(0, 5);
+	vec.swap_remove(3);
+	vec.template erase_if<0>([](const column<0> &c) { return c.value[0] > 1.0; });
+	Vec copy = vec;
+	copy.shrink_to_fit();
+	return touch_all(vec, std::make_index_sequence<Vec::num_slices>()) + copy.size();
+}
+
+}
+
+size_t compile_time_64()
+{
+	return exercise<make_vector<std::make_index_sequence<64>, utl::parallel_vector>::type>()
+		+ exercise<make_vector<std::make_index_sequence<64>, separate_vector>::type>();
+}
@@ -0,0 +1,719 @@
+#pragma once
+
+#include "array_view.h"
+
+#include <stdint.h>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define UTL_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define UTL_KERNELS_X86 0
+#endif
+
+/* Vectorized kernels operating on single slices (array views) of arithmetic types.
+ * Each kernel has SSE4.1 and AVX2 implementations for float, double and int32_t, selected at runtime based on CPU features; other types
+ * (and non-x86 targets) use scalar fallback. Raw pointers are extracted from views up front, so that aliasing through view object doesn't prevent vectorization.
+ * Note: floating-point sums and scans are evaluated in different order than naive loop, so results can differ in the last bits. Behaviour with NaNs is unspecified. */
+
+namespace utl {
+
+/* Simple comparison predicate for count_if: element <op> value. */
+enum class compare_op
+{
+	less,
+	less_equal,
+	greater,
+	greater_equal,
+	equal,
+	not_equal,
+};
+
+namespace detail {
+	/* Type used for accumulating sums: 64-bit for integers (so that int32 columns don't overflow), same type for floating point. */
+	template<typename T, bool Integral = std::is_integral<T>::value>
+	struct sum_type
+	{
+		using type = std::conditional_t<std::is_signed<T>::value, int64_t, uint64_t>;
+	};
+
+	template<typename T>
+	struct sum_type<T, false>
+	{
+		using type = T;
+	};
+
+	template<typename T>
+	using sum_type_t = typename sum_type<T>::type;
+
+	template<compare_op Op, typename T>
+	bool compare_scalar(T a, T b)
+	{
+		switch (Op)
+		{
+		case compare_op::less:			return a < b;
+		case compare_op::less_equal:	return a <= b;
+		case compare_op::greater:		return a > b;
+		case compare_op::greater_equal:	return a >= b;
+		case compare_op::equal:			return a == b;
+		case compare_op::not_equal:		return a != b;
+		}
+		return false;
+	}
+
+	inline unsigned count_trailing_zeros(unsigned mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return index;
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+	/* CPU features relevant for kernel selection, detected once. */
+	struct cpu_features
+	{
+		bool sse41 = false;
+		bool avx2 = false;
+
+		static const cpu_features &get()
+		{
+			static const cpu_features features = detect();
+			return features;
+		}
+
+	private:
+		static cpu_features detect()
+		{
+			cpu_features result;
+#if UTL_KERNELS_X86 && defined(_MSC_VER)
+			int regs[4];
+			__cpuid(regs, 0);
+			int maxLeaf = regs[0];
+			__cpuid(regs, 1);
+			result.sse41 = (regs[2] & (1 << 19)) != 0;
+			bool osxsave = (regs[2] & (1 << 27)) != 0;
+			bool avx = (regs[2] & (1 << 28)) != 0;
+			bool ymmEnabled = osxsave && (_xgetbv(0) & 6) == 6;
+			if (maxLeaf >= 7 && avx && ymmEnabled)
+			{
+				__cpuidex(regs, 7, 0);
+				result.avx2 = (regs[1] & (1 << 5)) != 0;
+			}
+#elif UTL_KERNELS_X86
+			__builtin_cpu_init();
+			result.sse41 = __builtin_cpu_supports("sse4.1");
+			result.avx2 = __builtin_cpu_supports("avx2");
+#endif
+			return result;
+		}
+	};
+
+	/* Scalar fallback, used for all arithmetic types. */
+	namespace scalar_kernels {
+		template<typename T>
+		sum_type_t<T> sum(const T *data, size_t size)
+		{
+			sum_type_t<T> result = 0;
+			for (size_t i = 0; i < size; ++i)
+				result += data[i];
+			return result;
+		}
+
+		template<typename T>
+		T min_value(const T *data, size_t size)
+		{
+			T result = data[0];
+			for (size_t i = 1; i < size; ++i)
+				result = data[i] < result ? data[i] : result;
+			return result;
+		}
+
+		template<typename T>
+		T max_value(const T *data, size_t size)
+		{
+			T result = data[0];
+			for (size_t i = 1; i < size; ++i)
+				result = data[i] > result ? data[i] : result;
+			return result;
+		}
+
+		template<typename T>
+		size_t argmin(const T *data, size_t size)
+		{
+			size_t result = 0;
+			for (size_t i = 1; i < size; ++i)
+				if (data[i] < data[result])
+					result = i;
+			return result;
+		}
+
+		template<typename T>
+		size_t argmax(const T *data, size_t size)
+		{
+			size_t result = 0;
+			for (size_t i = 1; i < size; ++i)
+				if (data[i] > data[result])
+					result = i;
+			return result;
+		}
+
+		template<typename T>
+		size_t count_if(const T *data, size_t size, compare_op op, T value)
+		{
+			size_t result = 0;
+			for (size_t i = 0; i < size; ++i)
+			{
+				switch (op)
+				{
+				case compare_op::less:			result += data[i] < value; break;
+				case compare_op::less_equal:	result += data[i] <= value; break;
+				case compare_op::greater:		result += data[i] > value; break;
+				case compare_op::greater_equal:	result += data[i] >= value; break;
+				case compare_op::equal:			result += data[i] == value; break;
+				case compare_op::not_equal:		result += data[i] != value; break;
+				}
+			}
+			return result;
+		}
+
+		template<typename T>
+		void inclusive_scan(const T *in, T *out, size_t size, T carry)
+		{
+			for (size_t i = 0; i < size; ++i)
+				out[i] = carry = carry + in[i];
+		}
+	}
+
+#if UTL_KERNELS_X86
+
+#define UTL_KERNELS_TARGET_PRAGMA(x) _Pragma(#x)
+#if defined(__clang__)
+#define UTL_KERNELS_TARGET_BEGIN(isa) UTL_KERNELS_TARGET_PRAGMA(clang attribute push(__attribute__((target(isa))), apply_to = function))
+#define UTL_KERNELS_TARGET_END _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+#define UTL_KERNELS_TARGET_BEGIN(isa) _Pragma("GCC push_options") UTL_KERNELS_TARGET_PRAGMA(GCC target(isa))
+#define UTL_KERNELS_TARGET_END _Pragma("GCC pop_options")
+#else
+#define UTL_KERNELS_TARGET_BEGIN(isa)
+#define UTL_KERNELS_TARGET_END
+#endif
+
+	/* SSE4.1 implementations (4 floats / 2 doubles / 4 ints per register). */
+	UTL_KERNELS_TARGET_BEGIN("sse4.1")
+	namespace sse41_kernels {
+		template<typename T> struct ops;
+
+		template<>
+		struct ops<float>
+		{
+			using reg = __m128;
+			static const constexpr size_t width = 4;
+
+			static reg load(const float *p) { return _mm_loadu_ps(p); }
+			static void store(float *p, reg x) { _mm_storeu_ps(p, x); }
+			static reg set1(float v) { return _mm_set1_ps(v); }
+			static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+			static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+			static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+			static unsigned movemask(reg m) { return _mm_movemask_ps(m); }
+
+			template<compare_op Op>
+			static reg compare(reg a, reg b)
+			{
+				switch (Op)
+				{
+				case compare_op::less:			return _mm_cmplt_ps(a, b);
+				case compare_op::less_equal:	return _mm_cmple_ps(a, b);
+				case compare_op::greater:		return _mm_cmpgt_ps(a, b);
+				case compare_op::greater_equal:	return _mm_cmpge_ps(a, b);
+				case compare_op::equal:			return _mm_cmpeq_ps(a, b);
+				case compare_op::not_equal:		return _mm_cmpneq_ps(a, b);
+				}
+				return a;
+			}
+
+			static reg prefix(reg x)
+			{
+				x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+				return _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+			}
+			static reg broadcast_last(reg x) { return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+			static float reduce_min(reg x)
+			{
+				x = _mm_min_ps(x, _mm_movehl_ps(x, x));
+				return _mm_cvtss_f32(_mm_min_ss(x, _mm_shuffle_ps(x, x, 1)));
+			}
+			static float reduce_max(reg x)
+			{
+				x = _mm_max_ps(x, _mm_movehl_ps(x, x));
+				return _mm_cvtss_f32(_mm_max_ss(x, _mm_shuffle_ps(x, x, 1)));
+			}
+
+			using sum_acc = __m128;
+			static sum_acc sum_zero() { return _mm_setzero_ps(); }
+			static sum_acc sum_add(sum_acc acc, reg x) { return _mm_add_ps(acc, x); }
+			static sum_acc sum_merge(sum_acc a, sum_acc b) { return _mm_add_ps(a, b); }
+			static float sum_total(sum_acc acc)
+			{
+				acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+				return _mm_cvtss_f32(_mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1)));
+			}
+
+			using count_acc = __m128i;
+			static count_acc count_zero() { return _mm_setzero_si128(); }
+			static count_acc count_add(count_acc acc, reg mask) { return _mm_sub_epi32(acc, _mm_castps_si128(mask)); }
+			static size_t count_total(count_acc acc)
+			{
+				alignas(16) uint32_t lanes[4];
+				_mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+				return size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+			}
+		};
+
+		template<>
+		struct ops<double>
+		{
+			using reg = __m128d;
+			static const constexpr size_t width = 2;
+
+			static reg load(const double *p) { return _mm_loadu_pd(p); }
+			static void store(double *p, reg x) { _mm_storeu_pd(p, x); }
+			static reg set1(double v) { return _mm_set1_pd(v); }
+			static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+			static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+			static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+			static unsigned movemask(reg m) { return _mm_movemask_pd(m); }
+
+			template<compare_op Op>
+			static reg compare(reg a, reg b)
+			{
+				switch (Op)
+				{
+				case compare_op::less:			return _mm_cmplt_pd(a, b);
+				case compare_op::less_equal:	return _mm_cmple_pd(a, b);
+				case compare_op::greater:		return _mm_cmpgt_pd(a, b);
+				case compare_op::greater_equal:	return _mm_cmpge_pd(a, b);
+				case compare_op::equal:			return _mm_cmpeq_pd(a, b);
+				case compare_op::not_equal:		return _mm_cmpneq_pd(a, b);
+				}
+				return a;
+			}
+
+			static reg prefix(reg x) { return _mm_add_pd(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8))); }
+			static reg broadcast_last(reg x) { return _mm_unpackhi_pd(x, x); }
+
+			static double reduce_min(reg x) { return _mm_cvtsd_f64(_mm_min_sd(x, _mm_unpackhi_pd(x, x))); }
+			static double reduce_max(reg x) { return _mm_cvtsd_f64(_mm_max_sd(x, _mm_unpackhi_pd(x, x))); }
+
+			using sum_acc = __m128d;
+			static sum_acc sum_zero() { return _mm_setzero_pd(); }
+			static sum_acc sum_add(sum_acc acc, reg x) { return _mm_add_pd(acc, x); }
+			static sum_acc sum_merge(sum_acc a, sum_acc b) { return _mm_add_pd(a, b); }
+			static double sum_total(sum_acc acc) { return _mm_cvtsd_f64(_mm_add_sd(acc, _mm_unpackhi_pd(acc, acc))); }
+
+			using count_acc = __m128i;
+			static count_acc count_zero() { return _mm_setzero_si128(); }
+			static count_acc count_add(count_acc acc, reg mask) { return _mm_sub_epi64(acc, _mm_castpd_si128(mask)); }
+			static size_t count_total(count_acc acc)
+			{
+				alignas(16) uint64_t lanes[2];
+				_mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+				return size_t(lanes[0] + lanes[1]);
+			}
+		};
+
+		template<>
+		struct ops<int32_t>
+		{
+			using reg = __m128i;
+			static const constexpr size_t width = 4;
+
+			static reg load(const int32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+			static void store(int32_t *p, reg x) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), x); }
+			static reg set1(int32_t v) { return _mm_set1_epi32(v); }
+			static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+			static reg min(reg a, reg b) { return _mm_min_epi32(a, b); }
+			static reg max(reg a, reg b) { return _mm_max_epi32(a, b); }
+			static unsigned movemask(reg m) { return _mm_movemask_ps(_mm_castsi128_ps(m)); }
+
+			template<compare_op Op>
+			static reg compare(reg a, reg b)
+			{
+				const reg ones = _mm_set1_epi32(-1);
+				switch (Op)
+				{
+				case compare_op::less:			return _mm_cmplt_epi32(a, b);
+				case compare_op::less_equal:	return _mm_xor_si128(_mm_cmpgt_epi32(a, b), ones);
+				case compare_op::greater:		return _mm_cmpgt_epi32(a, b);
+				case compare_op::greater_equal:	return _mm_xor_si128(_mm_cmplt_epi32(a, b), ones);
+				case compare_op::equal:			return _mm_cmpeq_epi32(a, b);
+				case compare_op::not_equal:		return _mm_xor_si128(_mm_cmpeq_epi32(a, b), ones);
+				}
+				return a;
+			}
+
+			static reg prefix(reg x)
+			{
+				x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+				return _mm_add_epi32(x, _mm_slli_si128(x, 8));
+			}
+			static reg broadcast_last(reg x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+			static int32_t reduce_min(reg x)
+			{
+				x = _mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+				return _mm_cvtsi128_si32(_mm_min_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1))));
+			}
+			static int32_t reduce_max(reg x)
+			{
+				x = _mm_max_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+				return _mm_cvtsi128_si32(_mm_max_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1))));
+			}
+
+			// sums are accumulated in 64-bit lanes
+			using sum_acc = __m128i;
+			static sum_acc sum_zero() { return _mm_setzero_si128(); }
+			static sum_acc sum_add(sum_acc acc, reg x)
+			{
+				acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(x));
+				return _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(x, 8)));
+			}
+			static sum_acc sum_merge(sum_acc a, sum_acc b) { return _mm_add_epi64(a, b); }
+			static int64_t sum_total(sum_acc acc)
+			{
+				alignas(16) int64_t lanes[2];
+				_mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+				return lanes[0] + lanes[1];
+			}
+
+			using count_acc = __m128i;
+			static count_acc count_zero() { return _mm_setzero_si128(); }
+			static count_acc count_add(count_acc acc, reg mask) { return _mm_sub_epi32(acc, mask); }
+			static size_t count_total(count_acc acc)
+			{
+				alignas(16) uint32_t lanes[4];
+				_mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+				return size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+			}
+		};
+
+#include "column_kernels_simd.inl"
+	}
+	UTL_KERNELS_TARGET_END
+
+	/* AVX2 implementations (8 floats / 4 doubles / 8 ints per register). */
+	UTL_KERNELS_TARGET_BEGIN("avx2")
+	namespace avx2_kernels {
+		template<typename T> struct ops;
+
+		template<>
+		struct ops<float>
+		{
+			using reg = __m256;
+			static const constexpr size_t width = 8;
+
+			static reg load(const float *p) { return _mm256_loadu_ps(p); }
+			static void store(float *p, reg x) { _mm256_storeu_ps(p, x); }
+			static reg set1(float v) { return _mm256_set1_ps(v); }
+			static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+			static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+			static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+			static unsigned movemask(reg m) { return _mm256_movemask_ps(m); }
+
+			template<compare_op Op>
+			static reg compare(reg a, reg b)
+			{
+				switch (Op)
+				{
+				case compare_op::less:			return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+				case compare_op::less_equal:	return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+				case compare_op::greater:		return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+				case compare_op::greater_equal:	return _mm256_cmp_ps(a, b, _CMP_GE_OQ);
+				case compare_op::equal:			return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+				case compare_op::not_equal:		return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ);
+				}
+				return a;
+			}
+
+			/* Prefix sum within 128-bit lanes, then propagate last element of lower lane into upper lane. */
+			static reg prefix(reg x)
+			{
+				x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+				x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+				reg lowLast = _mm256_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+				return _mm256_add_ps(x, _mm256_permute2f128_ps(lowLast, lowLast, 0x08));
+			}
+			static reg broadcast_last(reg x) { return _mm256_permutevar8x32_ps(x, _mm256_set1_epi32(7)); }
+
+			static float reduce_min(reg x) { return sse41_kernels::ops<float>::reduce_min(_mm_min_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1))); }
+			static float reduce_max(reg x) { return sse41_kernels::ops<float>::reduce_max(_mm_max_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1))); }
+
+			using sum_acc = __m256;
+			static sum_acc sum_zero() { return _mm256_setzero_ps(); }
+			static sum_acc sum_add(sum_acc acc, reg x) { return _mm256_add_ps(acc, x); }
+			static sum_acc sum_merge(sum_acc a, sum_acc b) { return _mm256_add_ps(a, b); }
+			static float sum_total(sum_acc acc) { return sse41_kernels::ops<float>::sum_total(_mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1))); }
+
+			using count_acc = __m256i;
+			static count_acc count_zero() { return _mm256_setzero_si256(); }
+			static count_acc count_add(count_acc acc, reg mask) { return _mm256_sub_epi32(acc, _mm256_castps_si256(mask)); }
+			static size_t count_total(count_acc acc)
+			{
+				alignas(32) uint32_t lanes[8];
+				_mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+				size_t result = 0;
+				for (uint32_t lane : lanes)
+					result += lane;
+				return result;
+			}
+		};
+
+		template<>
+		struct ops<double>
+		{
+			using reg = __m256d;
+			static const constexpr size_t width = 4;
+
+			static reg load(const double *p) { return _mm256_loadu_pd(p); }
+			static void store(double *p, reg x) { _mm256_storeu_pd(p, x); }
+			static reg set1(double v) { return _mm256_set1_pd(v); }
+			static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+			static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+			static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+			static unsigned movemask(reg m) { return _mm256_movemask_pd(m); }
+
+			template<compare_op Op>
+			static reg compare(reg a, reg b)
+			{
+				switch (Op)
+				{
+				case compare_op::less:			return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+				case compare_op::less_equal:	return _mm256_cmp_pd(a, b, _CMP_LE_OQ);
+				case compare_op::greater:		return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+				case compare_op::greater_equal:	return _mm256_cmp_pd(a, b, _CMP_GE_OQ);
+				case compare_op::equal:			return _mm256_cmp_pd(a, b, _CMP_EQ_OQ);
+				case compare_op::not_equal:		return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ);
+				}
+				return a;
+			}
+
+			static reg prefix(reg x)
+			{
+				x = _mm256_add_pd(x, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(x), 8)));
+				reg lowLast = _mm256_shuffle_pd(x, x, 0xF);
+				return _mm256_add_pd(x, _mm256_permute2f128_pd(lowLast, lowLast, 0x08));
+			}
+			static reg broadcast_last(reg x) { return _mm256_permute4x64_pd(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+			static double reduce_min(reg x) { return sse41_kernels::ops<double>::reduce_min(_mm_min_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1))); }
+			static double reduce_max(reg x) { return sse41_kernels::ops<double>::reduce_max(_mm_max_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1))); }
+
+			using sum_acc = __m256d;
+			static sum_acc sum_zero() { return _mm256_setzero_pd(); }
+			static sum_acc sum_add(sum_acc acc, reg x) { return _mm256_add_pd(acc, x); }
+			static sum_acc sum_merge(sum_acc a, sum_acc b) { return _mm256_add_pd(a, b); }
+			static double sum_total(sum_acc acc) { return sse41_kernels::ops<double>::sum_total(_mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1))); }
+
+			using count_acc = __m256i;
+			static count_acc count_zero() { return _mm256_setzero_si256(); }
+			static count_acc count_add(count_acc acc, reg mask) { return _mm256_sub_epi64(acc, _mm256_castpd_si256(mask)); }
+			static size_t count_total(count_acc acc)
+			{
+				alignas(32) uint64_t lanes[4];
+				_mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+				return size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+			}
+		};
+
+		template<>
+		struct ops<int32_t>
+		{
+			using reg = __m256i;
+			static const constexpr size_t width = 8;
+
+			static reg load(const int32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+			static void store(int32_t *p, reg x) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x); }
+			static reg set1(int32_t v) { return _mm256_set1_epi32(v); }
+			static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+			static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+			static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+			static unsigned movemask(reg m) { return _mm256_movemask_ps(_mm256_castsi256_ps(m)); }
+
+			template<compare_op Op>
+			static reg compare(reg a, reg b)
+			{
+				const reg ones = _mm256_set1_epi32(-1);
+				switch (Op)
+				{
+				case compare_op::less:			return _mm256_cmpgt_epi32(b, a);
+				case compare_op::less_equal:	return _mm256_xor_si256(_mm256_cmpgt_epi32(a, b), ones);
+				case compare_op::greater:		return _mm256_cmpgt_epi32(a, b);
+				case compare_op::greater_equal:	return _mm256_xor_si256(_mm256_cmpgt_epi32(b, a), ones);
+				case compare_op::equal:			return _mm256_cmpeq_epi32(a, b);
+				case compare_op::not_equal:		return _mm256_xor_si256(_mm256_cmpeq_epi32(a, b), ones);
+				}
+				return a;
+			}
+
+			static reg prefix(reg x)
+			{
+				x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+				x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+				reg lowLast = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+				return _mm256_add_epi32(x, _mm256_permute2x128_si256(lowLast, lowLast, 0x08));
+			}
+			static reg broadcast_last(reg x) { return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7)); }
+
+			static int32_t reduce_min(reg x) { return sse41_kernels::ops<int32_t>::reduce_min(_mm_min_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1))); }
+			static int32_t reduce_max(reg x) { return sse41_kernels::ops<int32_t>::reduce_max(_mm_max_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1))); }
+
+			// sums are accumulated in 64-bit lanes
+			using sum_acc = __m256i;
+			static sum_acc sum_zero() { return _mm256_setzero_si256(); }
+			static sum_acc sum_add(sum_acc acc, reg x)
+			{
+				acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+				return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+			}
+			static sum_acc sum_merge(sum_acc a, sum_acc b) { return _mm256_add_epi64(a, b); }
+			static int64_t sum_total(sum_acc acc)
+			{
+				alignas(32) int64_t lanes[4];
+				_mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+				return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+			}
+
+			using count_acc = __m256i;
+			static count_acc count_zero() { return _mm256_setzero_si256(); }
+			static count_acc count_add(count_acc acc, reg mask) { return _mm256_sub_epi32(acc, mask); }
+			static size_t count_total(count_acc acc)
+			{
+				alignas(32) uint32_t lanes[8];
+				_mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+				size_t result = 0;
+				for (uint32_t lane : lanes)
+					result += lane;
+				return result;
+			}
+		};
+
+#include "column_kernels_simd.inl"
+	}
+	UTL_KERNELS_TARGET_END
+
+#endif // UTL_KERNELS_X86
+
+	/* Whether SIMD implementations exist for given type. */
+	template<typename T>
+	struct has_simd_kernels : std::integral_constant<bool, UTL_KERNELS_X86 && (std::is_same<T, float>::value || std::is_same<T, double>::value || std::is_same<T, int32_t>::value)> {};
+
+	/* Table of kernel implementations for given type, selected once based on CPU features. */
+	template<typename T>
+	struct kernel_table
+	{
+		sum_type_t<T>	(*sum)(const T *, size_t);
+		T				(*min_value)(const T *, size_t);
+		T				(*max_value)(const T *, size_t);
+		size_t			(*argmin)(const T *, size_t);
+		size_t			(*argmax)(const T *, size_t);
+		size_t			(*count_if)(const T *, size_t, compare_op, T);
+		void			(*inclusive_scan)(const T *, T *, size_t, T);
+
+		static const kernel_table &get()
+		{
+			static const kernel_table table = select();
+			return table;
+		}
+
+	private:
+#define UTL_KERNELS_TABLE(ns) { &ns::sum<T>, &ns::min_value<T>, &ns::max_value<T>, &ns::argmin<T>, &ns::argmax<T>, &ns::count_if<T>, &ns::inclusive_scan<T> }
+		static kernel_table select()
+		{
+#if UTL_KERNELS_X86
+			if constexpr (has_simd_kernels<T>::value)
+			{
+				const auto &features = cpu_features::get();
+				if (features.avx2)
+					return UTL_KERNELS_TABLE(avx2_kernels);
+				if (features.sse41)
+					return UTL_KERNELS_TABLE(sse41_kernels);
+			}
+#endif
+			return UTL_KERNELS_TABLE(scalar_kernels);
+		}
+#undef UTL_KERNELS_TABLE
+	};
+
+	template<typename View>
+	using kernel_table_for = kernel_table<std::remove_const_t<typename View::value_type>>;
+}
+
+/* Column kernels. All of them accept any array view of arithmetic type, e.g. vec.slice<I>(). */
+namespace kernels {
+	/* Sum of all elements; integers are accumulated in 64 bits. */
+	template<typename T, size_t A>
+	auto sum(array_view<T, A> view)
+	{
+		return detail::kernel_table_for<array_view<T, A>>::get().sum(view.data(), view.size());
+	}
+
+	/* Smallest/largest element; view should not be empty. */
+	template<typename T, size_t A>
+	auto min_value(array_view<T, A> view)
+	{
+		return detail::kernel_table_for<array_view<T, A>>::get().min_value(view.data(), view.size());
+	}
+	template<typename T, size_t A>
+	auto max_value(array_view<T, A> view)
+	{
+		return detail::kernel_table_for<array_view<T, A>>::get().max_value(view.data(), view.size());
+	}
+
+	/* Index of first smallest/largest element (0 for empty view). */
+	template<typename T, size_t A>
+	size_t argmin(array_view<T, A> view)
+	{
+		return detail::kernel_table_for<array_view<T, A>>::get().argmin(view.data(), view.size());
+	}
+	template<typename T, size_t A>
+	size_t argmax(array_view<T, A> view)
+	{
+		return detail::kernel_table_for<array_view<T, A>>::get().argmax(view.data(), view.size());
+	}
+
+	/* Number of elements e for which "e <op> value" holds. */
+	template<typename T, size_t A>
+	size_t count_if(array_view<T, A> view, compare_op op, std::remove_const_t<T> value)
+	{
+		return detail::kernel_table_for<array_view<T, A>>::get().count_if(view.data(), view.size(), op, value);
+	}
+
+	/* out[i] = in[0] + ... + in[i]. Output should have the same size as input; scan can be done in place. */
+	template<typename T, size_t A, typename U, size_t B>
+	void inclusive_scan(array_view<T, A> in, array_view<U, B> out)
+	{
+		static_assert(std::is_same<std::remove_const_t<T>, U>::value, "Input and output element types should match");
+		detail::kernel_table_for<array_view<T, A>>::get().inclusive_scan(in.data(), out.data(), in.size(), U(0));
+	}
+
+	/* out[i] = init + in[0] + ... + in[i-1]. Output should have the same size as input and should not overlap it. */
+	template<typename T, size_t A, typename U, size_t B>
+	void exclusive_scan(array_view<T, A> in, array_view<U, B> out, U init = U(0))
+	{
+		static_assert(std::is_same<std::remove_const_t<T>, U>::value, "Input and output element types should match");
+		if (in.empty())
+			return;
+		out[0] = init;
+		detail::kernel_table_for<array_view<T, A>>::get().inclusive_scan(in.data(), out.data() + 1, in.size() - 1, init);
+	}
+}
+
+}
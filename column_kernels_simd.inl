@@ -0,0 +1,146 @@
+/* Generic SIMD column kernels, included by column_kernels.h once per instruction set into corresponding namespace (with matching compiler target options).
+ * Expects ops<T> specializations to be visible, each providing:
+ *   reg, width, load, store, set1, add, min, max, compare<Op>, movemask, prefix, broadcast_last, reduce_min, reduce_max,
+ *   sum_acc, sum_zero, sum_add, sum_merge, sum_total, count_acc, count_zero, count_add, count_total. */
+
+template<typename T>
+sum_type_t<T> sum(const T *data, size_t size)
+{
+	using O = ops<T>;
+	const size_t W = O::width;
+
+	// several independent accumulators to hide add latency
+	auto acc0 = O::sum_zero(), acc1 = O::sum_zero(), acc2 = O::sum_zero(), acc3 = O::sum_zero();
+	size_t i = 0;
+	for (; i + 4 * W <= size; i += 4 * W)
+	{
+		acc0 = O::sum_add(acc0, O::load(data + i));
+		acc1 = O::sum_add(acc1, O::load(data + i + W));
+		acc2 = O::sum_add(acc2, O::load(data + i + 2 * W));
+		acc3 = O::sum_add(acc3, O::load(data + i + 3 * W));
+	}
+	for (; i + W <= size; i += W)
+		acc0 = O::sum_add(acc0, O::load(data + i));
+
+	sum_type_t<T> result = O::sum_total(O::sum_merge(O::sum_merge(acc0, acc1), O::sum_merge(acc2, acc3)));
+	for (; i < size; ++i)
+		result += data[i];
+	return result;
+}
+
+template<typename T, bool Max>
+T extremum(const T *data, size_t size)
+{
+	using O = ops<T>;
+	const size_t W = O::width;
+
+	size_t i = 0;
+	T result = data[0];
+	if (size >= W)
+	{
+		auto acc = O::load(data);
+		for (i = W; i + W <= size; i += W)
+			acc = Max ? O::max(acc, O::load(data + i)) : O::min(acc, O::load(data + i));
+		result = Max ? O::reduce_max(acc) : O::reduce_min(acc);
+	}
+	for (; i < size; ++i)
+		result = Max ? (data[i] > result ? data[i] : result) : (data[i] < result ? data[i] : result);
+	return result;
+}
+
+template<typename T>
+T min_value(const T *data, size_t size)
+{
+	return extremum<T, false>(data, size);
+}
+
+template<typename T>
+T max_value(const T *data, size_t size)
+{
+	return extremum<T, true>(data, size);
+}
+
+template<typename T>
+size_t find_first_equal(const T *data, size_t size, T value)
+{
+	using O = ops<T>;
+	const size_t W = O::width;
+
+	auto v = O::set1(value);
+	size_t i = 0;
+	for (; i + W <= size; i += W)
+	{
+		unsigned mask = O::movemask(O::template compare<compare_op::equal>(O::load(data + i), v));
+		if (mask != 0)
+			return i + count_trailing_zeros(mask);
+	}
+	for (; i < size; ++i)
+		if (data[i] == value)
+			return i;
+	return size;
+}
+
+template<typename T>
+size_t argmin(const T *data, size_t size)
+{
+	return size > 0 ? find_first_equal(data, size, min_value(data, size)) : 0;
+}
+
+template<typename T>
+size_t argmax(const T *data, size_t size)
+{
+	return size > 0 ? find_first_equal(data, size, max_value(data, size)) : 0;
+}
+
+template<compare_op Op, typename T>
+size_t count_if_impl(const T *data, size_t size, T value)
+{
+	using O = ops<T>;
+	const size_t W = O::width;
+
+	auto v = O::set1(value);
+	auto acc = O::count_zero();
+	size_t i = 0;
+	for (; i + W <= size; i += W)
+		acc = O::count_add(acc, O::template compare<Op>(O::load(data + i), v));
+
+	size_t result = O::count_total(acc);
+	for (; i < size; ++i)
+		result += compare_scalar<Op>(data[i], value) ? 1 : 0;
+	return result;
+}
+
+template<typename T>
+size_t count_if(const T *data, size_t size, compare_op op, T value)
+{
+	switch (op)
+	{
+	case compare_op::less:			return count_if_impl<compare_op::less>(data, size, value);
+	case compare_op::less_equal:	return count_if_impl<compare_op::less_equal>(data, size, value);
+	case compare_op::greater:		return count_if_impl<compare_op::greater>(data, size, value);
+	case compare_op::greater_equal:	return count_if_impl<compare_op::greater_equal>(data, size, value);
+	case compare_op::equal:			return count_if_impl<compare_op::equal>(data, size, value);
+	case compare_op::not_equal:		return count_if_impl<compare_op::not_equal>(data, size, value);
+	}
+	return 0;
+}
+
+template<typename T>
+void inclusive_scan(const T *in, T *out, size_t size, T carry)
+{
+	using O = ops<T>;
+	const size_t W = O::width;
+
+	auto c = O::set1(carry);
+	size_t i = 0;
+	for (; i + W <= size; i += W)
+	{
+		auto x = O::add(O::prefix(O::load(in + i)), c);
+		O::store(out + i, x);
+		c = O::broadcast_last(x);
+	}
+
+	T running = i > 0 ? out[i - 1] : carry;
+	for (; i < size; ++i)
+		out[i] = running = running + in[i];
+}
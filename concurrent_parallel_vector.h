@@ -0,0 +1,403 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace utl {
+
+namespace detail {
+	/* Bit utilities for segment lookup & ready bitmap scanning; argument should be non-zero. */
+	inline size_t floor_log2(uint64_t value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return index;
+#else
+		return 63 - __builtin_clzll(value);
+#endif
+	}
+	inline size_t count_trailing_zeros(uint64_t value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return index;
+#else
+		return __builtin_ctzll(value);
+#endif
+	}
+
+	/* Storage for a single row constructed outside of the vector (elements are constructed and destroyed explicitly). */
+	template<typename TypeList>
+	struct row_buffer;
+
+	template<typename... Types>
+	struct row_buffer<type_list<Types...>>
+	{
+		std::tuple<std::aligned_storage_t<sizeof(Types), alignof(Types)>...> storage;
+
+		template<size_t Index>
+		auto element() { return reinterpret_cast<type_list_element_t<Index, type_list<Types...>> *>(&std::get<Index>(storage)); }
+	};
+
+	/* Whether construct(T *, Arg) can't throw; tuple arguments (unpacked into constructor arguments) are conservatively assumed to throw. */
+	template<typename T, typename Arg, typename = void>
+	struct is_nothrow_element_constructible : std::false_type {};
+
+	template<typename T, typename Arg>
+	struct is_nothrow_element_constructible<T, Arg, std::enable_if_t<!is_specialization_of<Arg, std::tuple>::value>> : std::bool_constant<noexcept(T{ std::declval<Arg>() })> {};
+
+	/* Concurrent parallel vector: many producers append rows without locking, consumers see only fully written rows.
+	 * Storage is a fixed table of segments with geometrically growing size (segment k holds FirstSegmentRows << k rows, each is an SoA block),
+	 * so growth never moves existing rows and readers are never blocked or invalidated; the only lock is taken by the thread allocating a new segment.
+	 * Protocol:
+	 * - producer claims a range of row slots with claim(count) (compare-and-swap on claimed counter), constructs every row with emplace(row, args...)
+	 *   and then calls publish(first, count); push_back does all three for a single row;
+	 * - size() returns length of the prefix of rows that are all published, so consumers can read rows [0, size()) while producers keep appending;
+	 *   publishing out of order is fine, prefix advances once gaps are filled.
+	 * Every claimed row should eventually be published, and clear()/destruction should not race with producers. */
+	template<typename TypeList, typename Traits, size_t FirstSegmentRows>
+	class concurrent_parallel_vector_impl : private Traits
+	{
+	public:
+		using size_type = size_t;
+		using types = TypeList;
+		using traits_type = Traits;
+
+		static const constexpr size_t num_slices = TypeList::size;
+		static const constexpr size_t first_segment_rows = FirstSegmentRows;
+		static const constexpr size_t max_segments = 40;
+		static const constexpr size_type max_rows = FirstSegmentRows * ((size_type(1) << max_segments) - 1);
+
+		/* Guaranteed alignment of the start of every slice within a segment. */
+		static const constexpr size_t slice_alignment = std::max(traits_slice_alignment<Traits>::value, std::max(type_list_layout<TypeList>::max_align, size_t(1)));
+		static_assert((FirstSegmentRows & (FirstSegmentRows - 1)) == 0 && FirstSegmentRows >= 64, "First segment size should be power-of-two, at least 64");
+		static_assert(FirstSegmentRows <= std::numeric_limits<size_type>::max() / ((size_type(1) << max_segments) - 1), "First segment size is too large");
+		static_assert(FirstSegmentRows % slice_alignment == 0, "First segment size should be a multiple of slice alignment");
+
+		explicit concurrent_parallel_vector_impl(const Traits &traits = Traits())
+			: Traits(traits)
+		{
+		}
+
+		concurrent_parallel_vector_impl(const concurrent_parallel_vector_impl &) = delete;
+		concurrent_parallel_vector_impl &operator=(const concurrent_parallel_vector_impl &) = delete;
+
+		~concurrent_parallel_vector_impl()
+		{
+			clear();
+			for (auto &segment : mSegments)
+				this->deallocate(segment.load(std::memory_order_relaxed));
+		}
+
+		/* Number of published rows (all rows below it are fully constructed and visible), claimed rows and rows in allocated segments. */
+		size_type size() const { return mPublished.load(std::memory_order_acquire); }
+		bool empty() const { return size() == 0; }
+		size_type claimed() const { return mClaimed.load(std::memory_order_relaxed); }
+		size_type capacity() const
+		{
+			size_t numSegments = 0;
+			while (numSegments < max_segments && mSegments[numSegments].load(std::memory_order_acquire))
+				++numSegments;
+			return segment_first_row(numSegments);
+		}
+
+		/* Access single element; valid for published rows, and for rows claimed by the calling producer. */
+		template<size_t Index> auto &get(size_type row)
+		{
+			return *element<Index>(row);
+		}
+		template<size_t Index> const auto &get(size_type row) const
+		{
+			return *element<Index>(row);
+		}
+		template<typename Type> auto &get(size_type row)
+		{
+			return get<find_type_index<Type, TypeList>::value>(row);
+		}
+		template<typename Type> const auto &get(size_type row) const
+		{
+			return get<find_type_index<Type, TypeList>::value>(row);
+		}
+
+		/* Call f(segmentSlice0, segmentSlice1, ...) for each segment containing published rows, passing views of selected slices (all if Indices is empty).
+		 * Rows published while iterating may or may not be visited. */
+		template<size_t... Indices, typename Func>
+		void for_each_segment(Func &&f)
+		{
+			for_each_segment_impl(*this, f, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+		template<size_t... Indices, typename Func>
+		void for_each_segment(Func &&f) const
+		{
+			for_each_segment_impl(*this, f, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+
+		/* Make sure segments for given number of rows are allocated. Thread-safe. */
+		void reserve(size_type capacity)
+		{
+			if (capacity > 0)
+				ensure_segments(0, capacity);
+		}
+
+		/* Claim count consecutive row slots, returning index of the first one. Slots are uninitialized until constructed with emplace. Thread-safe.
+		 * Segments are allocated before slots are taken, so if claim throws (std::length_error past max_rows, or allocation failure), nothing is claimed. */
+		size_type claim(size_type count = 1)
+		{
+			size_type first = mClaimed.load(std::memory_order_relaxed);
+			do
+			{
+				if (count > max_rows - first)
+					throw std::length_error("Concurrent parallel vector is too large");
+				if (count > 0)
+					ensure_segments(first, first + count);
+			} while (!mClaimed.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+			return first;
+		}
+
+		/* Construct row in a claimed slot; same argument semantics as parallel_vector_impl::push_back.
+		 * If some constructor throws, already constructed elements of the row are destroyed and the slot stays unconstructed; it still has to be
+		 * constructed and published eventually, otherwise size() never advances past it. */
+		template<typename... Args>
+		void emplace(size_type row, Args &&... args)
+		{
+			construct_row([this, row](auto sliceIndex) { return element<decltype(sliceIndex)::value>(row); }, std::forward<Args>(args)...);
+		}
+
+		/* Mark constructed rows [first, first + count) as ready and advance published size over all contiguous ready rows. Thread-safe, lock-free. */
+		void publish(size_type first, size_type count)
+		{
+			for (size_type row = first, end = first + count; row < end; )
+			{
+				size_t segment = segment_index(row);
+				size_type offset = row - segment_first_row(segment);
+				size_type bit = offset % 64;
+				size_type n = std::min<size_type>(64 - bit, end - row);
+				uint64_t mask = (n == 64 ? ~uint64_t(0) : ((uint64_t(1) << n) - 1)) << bit;
+				ready_words(segment_memory(segment), segment)[offset / 64].fetch_or(mask);
+				row += n;
+			}
+
+			// seq_cst bit updates & loads guarantee that at least one of concurrently publishing producers sees all their bits
+			size_type published = mPublished.load();
+			for (;;)
+			{
+				size_type ready = scan_ready(published);
+				if (ready == published || mPublished.compare_exchange_weak(published, ready))
+					break;
+			}
+		}
+
+		/* Append single row and publish it; returns its index. Thread-safe.
+		 * If constructing the row can throw, it is constructed aside and relocated into the slot after claiming (claimed slot can't be given back),
+		 * so a throwing constructor leaves the vector unchanged; this requires element types to be nothrow move constructible or trivially relocatable. */
+		template<typename... Args>
+		size_type push_back(Args &&... args)
+		{
+			if constexpr (is_nothrow_row_constructible(type_list<Args...>(), std::make_index_sequence<TypeList::size>()))
+			{
+				size_type row = claim(1);
+				emplace(row, std::forward<Args>(args)...);
+				publish(row, 1);
+				return row;
+			}
+			else
+			{
+				static_assert(is_nothrow_row_relocatable(std::make_index_sequence<TypeList::size>()),
+					"Row with throwing construction should be nothrow relocatable; use claim/emplace/publish instead");
+				row_buffer<TypeList> staged;
+				auto stagedElement = [&staged](auto sliceIndex) { return staged.template element<decltype(sliceIndex)::value>(); };
+				construct_row(stagedElement, std::forward<Args>(args)...);
+
+				size_type row;
+				try
+				{
+					row = claim(1);
+				}
+				catch (...)
+				{
+					seq_call<TypeList::size>::execute([&stagedElement](auto sliceIndex) { destroy(stagedElement(sliceIndex)); });
+					throw;
+				}
+				seq_call<TypeList::size>::execute([this, row, &stagedElement](auto sliceIndex) {
+					relocate_range(element<decltype(sliceIndex)::value>(row), stagedElement(sliceIndex), 1);
+				});
+				publish(row, 1);
+				return row;
+			}
+		}
+
+		/* Destroy all rows; segments are kept allocated. Not thread-safe. */
+		void clear()
+		{
+			size_type size = mPublished.load(std::memory_order_relaxed);
+			for (size_t segment = 0; segment < max_segments && segment_first_row(segment) < size; ++segment)
+			{
+				void *mem = segment_memory(segment);
+				size_type rows = std::min(segment_rows(segment), size - segment_first_row(segment));
+				seq_call<TypeList::size>::execute([mem, segment, rows](auto sliceIndex) {
+					auto *slice = slice_start<decltype(sliceIndex)::value>(mem, segment);
+					for (size_type i = 0; i < rows; ++i)
+						destroy(slice + i);
+				});
+				auto *ready = ready_words(mem, segment);
+				for (size_type w = 0; w < segment_rows(segment) / 64; ++w)
+					ready[w].store(0, std::memory_order_relaxed);
+			}
+			mPublished.store(0, std::memory_order_relaxed);
+			mClaimed.store(0, std::memory_order_relaxed);
+		}
+
+		/* Access traits instance used by this vector. */
+		const Traits &traits() const { return *this; }
+
+	private:
+		/* Segment geometry: segment k contains rows [FirstSegmentRows * (2^k - 1), FirstSegmentRows * (2^(k+1) - 1)). */
+		static size_t segment_index(size_type row) { return floor_log2(row / FirstSegmentRows + 1); }
+		static size_type segment_first_row(size_t segment) { return FirstSegmentRows * ((size_type(1) << segment) - 1); }
+		static size_type segment_rows(size_t segment) { return FirstSegmentRows << segment; }
+
+		/* Segment block layout: slices (staggered like separately allocated slices, to avoid cache set aliasing between power-of-two sized slices),
+		 * followed by ready bitmap (one bit per row). */
+		static constexpr size_t slice_stagger()
+		{
+			return slice_alignment > 64 ? slice_alignment : 64;
+		}
+		template<size_t Index>
+		static auto slice_start(void *mem, size_t segment)
+		{
+			void *start = static_cast<char *>(mem) + segment_rows(segment) * type_list_layout<TypeList>::offsets[Index] + Index * slice_stagger();
+			return static_cast<type_list_element_t<Index, TypeList> *>(start);
+		}
+		static size_t ready_offset(size_t segment)
+		{
+			return (segment_rows(segment) * type_list_layout<TypeList>::sum_size + TypeList::size * slice_stagger() + 7) & ~size_t(7);
+		}
+		static std::atomic<uint64_t> *ready_words(void *mem, size_t segment)
+		{
+			return reinterpret_cast<std::atomic<uint64_t> *>(static_cast<char *>(mem) + ready_offset(segment));
+		}
+
+		void *segment_memory(size_t segment) const
+		{
+			return mSegments[segment].load(std::memory_order_acquire);
+		}
+
+		template<size_t Index>
+		auto element(size_type row) const
+		{
+			size_t segment = segment_index(row);
+			return slice_start<Index>(segment_memory(segment), segment) + (row - segment_first_row(segment));
+		}
+
+		/* Construct every element of a row at elementAt(sliceIndex); all-or-nothing. */
+		template<typename ElementAt, typename... Args>
+		static void construct_row(ElementAt &&elementAt, Args &&... args)
+		{
+			size_t numDone = 0;
+			try
+			{
+				seq_call<TypeList::size>::execute([&elementAt, &numDone, argTuple = std::forward_as_tuple(std::forward<Args>(args)...)](auto sliceIndex) mutable {
+					construct(elementAt(sliceIndex), std::get<decltype(sliceIndex)::value>(std::move(argTuple)));
+					++numDone;
+				});
+			}
+			catch (...)
+			{
+				seq_call<TypeList::size>::execute([&elementAt, numDone](auto sliceIndex) {
+					if (decltype(sliceIndex)::value < numDone)
+						destroy(elementAt(sliceIndex));
+				});
+				throw;
+			}
+		}
+
+		template<typename... Args, size_t... Indices>
+		static constexpr bool is_nothrow_row_constructible(type_list<Args...>, std::index_sequence<Indices...>)
+		{
+			return (is_nothrow_element_constructible<type_list_element_t<Indices, TypeList>, Args>::value && ...);
+		}
+		template<size_t... Indices>
+		static constexpr bool is_nothrow_row_relocatable(std::index_sequence<Indices...>)
+		{
+			return ((is_trivially_relocatable<type_list_element_t<Indices, TypeList>>::value || std::is_nothrow_move_constructible<type_list_element_t<Indices, TypeList>>::value) && ...);
+		}
+
+		/* Allocate all missing segments covering rows [first, end); only allocation itself is serialized. */
+		void ensure_segments(size_type first, size_type end)
+		{
+			size_t last = segment_index(end - 1);
+			if (last >= max_segments)
+				throw std::length_error("Concurrent parallel vector is too large");
+
+			for (size_t segment = segment_index(first); segment <= last; ++segment)
+			{
+				if (segment_memory(segment))
+					continue;
+
+				std::lock_guard<std::mutex> lock(mGrowMutex);
+				if (mSegments[segment].load(std::memory_order_relaxed))
+					continue; // allocated by other thread while we were waiting
+
+				size_t numWords = segment_rows(segment) / 64;
+				void *mem = this->allocate(ready_offset(segment) + numWords * sizeof(uint64_t));
+				auto *ready = ready_words(mem, segment);
+				for (size_t w = 0; w < numWords; ++w)
+					new(ready + w) std::atomic<uint64_t>(0);
+				mSegments[segment].store(mem, std::memory_order_release);
+			}
+		}
+
+		/* Find first row at or after given one that is not ready. */
+		size_type scan_ready(size_type row) const
+		{
+			for (;;)
+			{
+				size_t segment = segment_index(row);
+				if (segment >= max_segments)
+					return row;
+				void *mem = segment_memory(segment);
+				if (!mem)
+					return row;
+
+				size_type offset = row - segment_first_row(segment);
+				size_type bit = offset % 64;
+				uint64_t pending = ~ready_words(mem, segment)[offset / 64].load() >> bit;
+				if (pending != 0)
+					return row + count_trailing_zeros(pending);
+				row += 64 - bit;
+			}
+		}
+
+		template<typename Self, typename Func, size_t... Indices>
+		static void for_each_segment_impl(Self &self, Func &f, std::index_sequence<Indices...>)
+		{
+			size_type size = self.size();
+			for (size_t segment = 0; segment < max_segments && segment_first_row(segment) < size; ++segment)
+			{
+				void *mem = self.segment_memory(segment);
+				size_type rows = std::min(segment_rows(segment), size - segment_first_row(segment));
+				f(make_array_view(static_cast<std::conditional_t<std::is_const<Self>::value, const type_list_element_t<Indices, TypeList>, type_list_element_t<Indices, TypeList>> *>(slice_start<Indices>(mem, segment)), rows)...);
+			}
+		}
+
+	private:
+		std::atomic<void *>		mSegments[max_segments] = {};
+		std::atomic<size_type>	mClaimed{ 0 };
+		std::atomic<size_type>	mPublished{ 0 };
+		std::mutex				mGrowMutex;
+	};
+}
+
+/* Concurrent parallel vector with default traits; first segment holds 1024 rows. */
+template<typename... Types>
+using concurrent_parallel_vector = detail::concurrent_parallel_vector_impl<detail::type_list<Types...>, default_parallel_vector_traits, 1024>;
+
+}
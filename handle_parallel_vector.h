@@ -0,0 +1,168 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+#include <limits>
+#include <stdint.h>
+#include <vector>
+
+namespace utl {
+
+namespace detail {
+	/* Parallel vector addressed by stable generational handles (sparse set): rows are kept densely packed in a regular parallel vector,
+	 * so iteration over slices is as fast as for plain vector, while removal swaps the last row into the hole and patches the handle table.
+	 * Handle is (slot, generation); slot is reused after removal with incremented generation, so stale handles are detected in O(1).
+	 * Row indices are not stable (removal moves the last row), handles are. */
+	template<typename TypeList, typename Traits>
+	class handle_parallel_vector_impl
+	{
+	public:
+		using rows_type = parallel_vector_impl<TypeList, without_auto_shrink_t<Traits>>;
+		using size_type = typename rows_type::size_type;
+		using types = TypeList;
+
+		static const constexpr size_type npos = std::numeric_limits<size_type>::max();
+		static const constexpr size_t num_slices = TypeList::size;
+
+		/* Default-constructed handle is invalid and never refers to a row. */
+		struct handle
+		{
+			uint32_t slot = std::numeric_limits<uint32_t>::max();
+			uint32_t generation = 0;
+
+			friend bool operator==(const handle &lhs, const handle &rhs) { return lhs.slot == rhs.slot && lhs.generation == rhs.generation; }
+			friend bool operator!=(const handle &lhs, const handle &rhs) { return !(lhs == rhs); }
+		};
+
+		handle_parallel_vector_impl() = default;
+		explicit handle_parallel_vector_impl(const Traits &traits) : mRows(traits) {}
+
+		/* Number of live rows. */
+		bool empty() const { return mRows.empty(); }
+		size_type size() const { return mRows.size(); }
+		size_type capacity() const { return mRows.capacity(); }
+
+		/* Dense storage; row order is arbitrary. Use slices for iteration. */
+		const rows_type &rows() const { return mRows; }
+		template<size_t Index> auto slice() { return mRows.template slice<Index>(); }
+		template<size_t Index> auto slice() const { return mRows.template slice<Index>(); }
+		template<typename Type> auto slice() { return mRows.template slice<Type>(); }
+		template<typename Type> auto slice() const { return mRows.template slice<Type>(); }
+
+		/* Reserve space for given number of rows and handles. */
+		void reserve(size_type capacity)
+		{
+			mRows.reserve(capacity);
+			mRowSlots.reserve(capacity);
+			mSlots.reserve(capacity);
+		}
+
+		/* Append new row (same arguments as parallel_vector_impl::push_back) and return its handle. */
+		template<typename... Args>
+		handle insert(Args &&... args)
+		{
+			mRowSlots.push_back(0);
+			try
+			{
+				if (mFreeHead == kNoSlot)
+				{
+					mSlots.push_back({ kNoSlot, 1 });
+					mFreeHead = static_cast<uint32_t>(mSlots.size() - 1);
+				}
+				mRows.push_back(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				mRowSlots.pop_back();
+				throw;
+			}
+
+			uint32_t slotIndex = mFreeHead;
+			auto &s = mSlots[slotIndex];
+			mFreeHead = s.rowOrNextFree;
+			s.rowOrNextFree = mRows.size() - 1;
+			mRowSlots.back() = slotIndex;
+			return { slotIndex, s.generation };
+		}
+
+		/* Remove row referenced by handle (last row is moved into its place); returns false if handle is stale. */
+		bool erase(handle h)
+		{
+			size_type row = find(h);
+			if (row == npos)
+				return false;
+
+			size_type last = mRows.size() - 1;
+			mRows.swap_remove(row);
+			if (row != last)
+			{
+				mRowSlots[row] = mRowSlots[last];
+				mSlots[mRowSlots[row]].rowOrNextFree = row;
+			}
+			mRowSlots.pop_back();
+			release_slot(h.slot);
+			return true;
+		}
+
+		/* Row index for handle, or npos if handle is stale or invalid. Valid until next removal. */
+		size_type find(handle h) const
+		{
+			if (h.slot >= mSlots.size() || mSlots[h.slot].generation != h.generation)
+				return npos;
+			return mSlots[h.slot].rowOrNextFree;
+		}
+		bool contains(handle h) const { return find(h) != npos; }
+
+		/* Handle of row at given dense index (e.g. while iterating slices). */
+		handle handle_at(size_type row) const
+		{
+			uint32_t slotIndex = mRowSlots[row];
+			return { slotIndex, mSlots[slotIndex].generation };
+		}
+
+		/* Access single element by handle; handle should be valid. */
+		template<size_t Index> auto &get(handle h) { return mRows.template slice<Index>()[mSlots[h.slot].rowOrNextFree]; }
+		template<size_t Index> const auto &get(handle h) const { return mRows.template slice<Index>()[mSlots[h.slot].rowOrNextFree]; }
+		template<typename Type> auto &get(handle h) { return get<find_type_index<Type, TypeList>::value>(h); }
+		template<typename Type> const auto &get(handle h) const { return get<find_type_index<Type, TypeList>::value>(h); }
+
+		/* Remove all rows; all outstanding handles become stale. */
+		void clear()
+		{
+			for (uint32_t slotIndex : mRowSlots)
+				release_slot(slotIndex);
+			mRowSlots.clear();
+			mRows.clear();
+		}
+
+	private:
+		static const constexpr uint32_t kNoSlot = std::numeric_limits<uint32_t>::max();
+
+		/* Row index for live slots, next free slot index for free ones; generation is bumped on release, so free slot's generation was never handed out. */
+		struct slot
+		{
+			uint32_t rowOrNextFree;
+			uint32_t generation;
+		};
+
+		void release_slot(uint32_t slotIndex)
+		{
+			auto &s = mSlots[slotIndex];
+			++s.generation;
+			s.rowOrNextFree = mFreeHead;
+			mFreeHead = slotIndex;
+		}
+
+	private:
+		rows_type				mRows;
+		std::vector<uint32_t>	mRowSlots;		// dense row -> slot
+		std::vector<slot>		mSlots;			// sparse slot -> dense row
+		uint32_t				mFreeHead = kNoSlot;
+	};
+}
+
+/* Handle-addressed parallel vector with default traits. */
+template<typename... Types>
+using handle_parallel_vector = detail::handle_parallel_vector_impl<detail::type_list<Types...>, default_parallel_vector_traits>;
+
+}
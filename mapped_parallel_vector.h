@@ -0,0 +1,325 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Binary snapshots of parallel vectors with trivially copyable types.
+ * File layout (native byte order, version 1):
+ *   snapshot_header
+ *   snapshot_slice_desc[numSlices]	- element size/alignment signature of the type list and file offset of each slice
+ *   slice data					- every slice is stored contiguously, starting at snapshot_alignment boundary
+ * Snapshot can be loaded back into a regular parallel vector, or mapped read-only with mapped_parallel_vector, whose slices point straight into the mapping
+ * (opening a snapshot costs the same regardless of its size; pages are read lazily by the OS on first access). */
+
+namespace utl {
+
+/* Alignment of slice data inside snapshot file; since mappings are page-aligned, this is also alignment of mapped slices. */
+static const constexpr size_t snapshot_alignment = 64;
+
+namespace detail {
+	struct snapshot_header
+	{
+		char		magic[8];		// kSnapshotMagic
+		uint32_t	version;		// kSnapshotVersion
+		uint32_t	byteOrder;		// kSnapshotByteOrder as written by the producer; mismatch means file was written on machine with different endianness
+		uint64_t	numRows;
+		uint32_t	numSlices;
+		uint32_t	reserved;
+	};
+
+	struct snapshot_slice_desc
+	{
+		uint32_t	elementSize;
+		uint32_t	elementAlignment;
+		uint64_t	offset;			// from the start of the file
+	};
+
+	static const constexpr char kSnapshotMagic[8] = { 'U', 'T', 'L', 'P', 'V', 'E', 'C', 0 };
+	static const constexpr uint32_t kSnapshotVersion = 1;
+	static const constexpr uint32_t kSnapshotByteOrder = 0x01020304;
+
+	/* Offset of the data of the first slice (just past the descriptors, rounded to alignment). */
+	inline uint64_t snapshot_data_start(size_t numSlices)
+	{
+		uint64_t end = sizeof(snapshot_header) + numSlices * sizeof(snapshot_slice_desc);
+		return (end + snapshot_alignment - 1) & ~uint64_t(snapshot_alignment - 1);
+	}
+
+	/* Fill slice descriptors for given type list and row count; returns total file size. */
+	template<typename TypeList>
+	uint64_t snapshot_layout(snapshot_slice_desc *descs, uint64_t numRows)
+	{
+		uint64_t offset = snapshot_data_start(TypeList::size);
+		seq_call<TypeList::size>::execute([&](auto sliceIndex) {
+			using type = type_list_element_t<decltype(sliceIndex)::value, TypeList>;
+			static_assert(std::is_trivially_copyable<type>::value, "Snapshots support only trivially copyable types");
+			static_assert(alignof(type) <= snapshot_alignment, "Type alignment exceeds snapshot alignment");
+
+			auto &desc = descs[decltype(sliceIndex)::value];
+			desc.elementSize = sizeof(type);
+			desc.elementAlignment = alignof(type);
+			desc.offset = offset;
+			offset = (offset + numRows * sizeof(type) + snapshot_alignment - 1) & ~uint64_t(snapshot_alignment - 1);
+		});
+		return offset;
+	}
+
+	/* Check that memory block contains valid snapshot of given type list; returns number of rows. Throws std::runtime_error otherwise. */
+	template<typename TypeList>
+	uint64_t validate_snapshot(const void *data, uint64_t dataSize)
+	{
+		if (dataSize < snapshot_data_start(TypeList::size))
+			throw std::runtime_error("Snapshot is truncated");
+
+		snapshot_header header;
+		std::memcpy(&header, data, sizeof(header));
+		if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0)
+			throw std::runtime_error("File is not a parallel vector snapshot");
+		if (header.byteOrder != kSnapshotByteOrder)
+			throw std::runtime_error("Snapshot was written with different byte order");
+		if (header.version != kSnapshotVersion)
+			throw std::runtime_error("Unsupported snapshot version");
+		if (header.numSlices != TypeList::size)
+			throw std::runtime_error("Snapshot slice count does not match type list");
+
+		// bound row count by file size first, so that layout arithmetic below can't overflow (slice padding adds less than numSlices * alignment)
+		static const constexpr uint64_t kRowBytes = std::max<uint64_t>(type_list_layout<TypeList>::sum_size, 1);
+		if (header.numRows > (dataSize - snapshot_data_start(TypeList::size)) / kRowBytes)
+			throw std::runtime_error("Snapshot is truncated");
+
+		snapshot_slice_desc expected[TypeList::size], actual[TypeList::size];
+		uint64_t expectedSize = snapshot_layout<TypeList>(expected, header.numRows);
+		std::memcpy(actual, static_cast<const char *>(data) + sizeof(header), sizeof(actual));
+		for (size_t i = 0; i < TypeList::size; ++i)
+			if (actual[i].elementSize != expected[i].elementSize || actual[i].elementAlignment != expected[i].elementAlignment)
+				throw std::runtime_error("Snapshot type signature does not match type list");
+		if (std::memcmp(actual, expected, sizeof(actual)) != 0 || dataSize < expectedSize)
+			throw std::runtime_error("Snapshot layout is corrupted");
+		return header.numRows;
+	}
+
+	/* Read-only mapping of a parallel vector snapshot. Slices are views into the mapping, which lives as long as the object. */
+	template<typename TypeList>
+	class mapped_parallel_vector_impl
+	{
+	public:
+		using size_type = size_t;
+		using types = TypeList;
+
+		static const constexpr size_t num_slices = TypeList::size;
+		static const constexpr size_t slice_alignment = snapshot_alignment;
+
+		/* Create empty (unmapped) vector. */
+		mapped_parallel_vector_impl() = default;
+
+		/* Map snapshot file and validate its header. Throws std::runtime_error if file can't be mapped or doesn't match the type list. */
+		explicit mapped_parallel_vector_impl(const char *path)
+		{
+			map(path);
+			try
+			{
+				mSize = static_cast<size_type>(validate_snapshot<TypeList>(mMapping, mMappingSize));
+			}
+			catch (...)
+			{
+				unmap();
+				throw;
+			}
+		}
+
+		/* Non-copyable, movable. */
+		mapped_parallel_vector_impl(const mapped_parallel_vector_impl &) = delete;
+		mapped_parallel_vector_impl &operator=(const mapped_parallel_vector_impl &) = delete;
+
+		mapped_parallel_vector_impl(mapped_parallel_vector_impl &&rhs) noexcept
+			: mMapping(rhs.mMapping)
+			, mMappingSize(rhs.mMappingSize)
+			, mSize(rhs.mSize)
+		{
+			rhs.mMapping = nullptr;
+			rhs.mMappingSize = rhs.mSize = 0;
+		}
+		mapped_parallel_vector_impl &operator=(mapped_parallel_vector_impl &&rhs) noexcept
+		{
+			unmap();
+
+			mMapping = rhs.mMapping;
+			mMappingSize = rhs.mMappingSize;
+			mSize = rhs.mSize;
+
+			rhs.mMapping = nullptr;
+			rhs.mMappingSize = rhs.mSize = 0;
+
+			return *this;
+		}
+
+		~mapped_parallel_vector_impl()
+		{
+			unmap();
+		}
+
+		/* Access single slice; views point directly into the mapping. */
+		template<size_t Index> auto slice() const
+		{
+			return make_aligned_array_view<slice_alignment>(slice_start<Index>(), mSize);
+		}
+		template<typename Type> auto slice() const
+		{
+			return slice<find_type_index<Type, TypeList>::value>();
+		}
+
+		/* Information about size. */
+		bool empty() const { return mSize == 0; }
+		size_type size() const { return mSize; }
+
+	private:
+		template<size_t Index>
+		auto slice_start() const
+		{
+			using type = type_list_element_t<Index, TypeList>;
+			if (!mMapping)
+				return static_cast<const type *>(nullptr);
+
+			snapshot_slice_desc desc;
+			std::memcpy(&desc, static_cast<const char *>(mMapping) + sizeof(snapshot_header) + Index * sizeof(snapshot_slice_desc), sizeof(desc));
+			return reinterpret_cast<const type *>(static_cast<const char *>(mMapping) + desc.offset);
+		}
+
+		void map(const char *path)
+		{
+#ifdef _WIN32
+			HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+				throw std::runtime_error("Failed to open snapshot file");
+
+			LARGE_INTEGER fileSize;
+			HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+			CloseHandle(file);
+			if (!mapping)
+				throw std::runtime_error("Failed to map snapshot file");
+
+			// view keeps the mapping object alive
+			mMapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+			if (!mMapping)
+				throw std::runtime_error("Failed to map snapshot file");
+			mMappingSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+			int fd = ::open(path, O_RDONLY);
+			if (fd < 0)
+				throw std::runtime_error("Failed to open snapshot file");
+
+			struct stat st;
+			void *mapping = fstat(fd, &st) == 0 && st.st_size > 0 ? mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+			::close(fd); // mapping keeps the file alive
+			if (mapping == MAP_FAILED)
+				throw std::runtime_error("Failed to map snapshot file");
+
+			mMapping = mapping;
+			mMappingSize = static_cast<size_t>(st.st_size);
+#endif
+		}
+
+		void unmap()
+		{
+			if (!mMapping)
+				return;
+#ifdef _WIN32
+			UnmapViewOfFile(mMapping);
+#else
+			munmap(mMapping, mMappingSize);
+#endif
+			mMapping = nullptr;
+		}
+
+	private:
+		void		*mMapping		= nullptr;
+		size_t		mMappingSize	= 0;
+		size_type	mSize			= 0;
+	};
+}
+
+/* Read-only memory-mapped snapshot with given types (should match types of saved vector). */
+template<typename... Types>
+using mapped_parallel_vector = detail::mapped_parallel_vector_impl<detail::type_list<Types...>>;
+
+/* Write snapshot of parallel vector (or any container with the same slice interface) to file. Every slice is written with a single call.
+ * Throws std::runtime_error on I/O failure. */
+template<typename Vec>
+void save_snapshot(const Vec &vec, const char *path)
+{
+	using type_list = typename Vec::types;
+
+	detail::snapshot_header header = {};
+	std::memcpy(header.magic, detail::kSnapshotMagic, sizeof(header.magic));
+	header.version = detail::kSnapshotVersion;
+	header.byteOrder = detail::kSnapshotByteOrder;
+	header.numRows = vec.size();
+	header.numSlices = type_list::size;
+
+	detail::snapshot_slice_desc descs[type_list::size];
+	detail::snapshot_layout<type_list>(descs, header.numRows);
+
+	std::FILE *file = std::fopen(path, "wb");
+	if (!file)
+		throw std::runtime_error("Failed to create snapshot file");
+
+	// write everything sequentially, padding gaps between slices with zeros
+	static const char kPadding[snapshot_alignment] = {};
+	uint64_t written = 0;
+	bool ok = true;
+	auto write = [&](const void *data, uint64_t size) {
+		ok = ok && (size == 0 || std::fwrite(data, 1, static_cast<size_t>(size), file) == size);
+		written += size;
+	};
+	auto pad_to = [&](uint64_t offset) {
+		write(kPadding, offset - written);
+	};
+
+	write(&header, sizeof(header));
+	write(descs, sizeof(descs));
+	detail::seq_call<type_list::size>::execute([&](auto sliceIndex) {
+		static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+		auto slice = vec.template slice<kSliceIndex>();
+		pad_to(descs[kSliceIndex].offset);
+		write(slice.data(), slice.size() * sizeof(*slice.data()));
+	});
+	pad_to((written + snapshot_alignment - 1) & ~uint64_t(snapshot_alignment - 1));
+
+	ok = std::fclose(file) == 0 && ok;
+	if (!ok)
+		throw std::runtime_error("Failed to write snapshot file");
+}
+
+/* Replace contents of parallel vector with snapshot contents; every slice is copied with a single memcpy from the mapping. */
+template<typename Vec>
+void load_snapshot(Vec &vec, const char *path)
+{
+	detail::mapped_parallel_vector_impl<typename Vec::types> mapped(path);
+	if (mapped.size() > std::numeric_limits<typename Vec::size_type>::max())
+		throw std::runtime_error("Snapshot is too large for vector size type");
+
+	vec.clear();
+	vec.insert_copy(0, mapped, 0, mapped.size());
+}
+
+}
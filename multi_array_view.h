@@ -0,0 +1,186 @@
+#pragma once
+
+#include "array_view.h"
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace utl {
+
+/* Proxy reference to a single row of multi array view: tuple of references to elements with the same index in several arrays.
+ * Derives from std::tuple<T &...>, so std::get, structured bindings and lexicographical comparisons (also against value_type) work as for tuples.
+ * Assignment assigns through references (moving elements when assigned from rvalue), swap swaps referenced elements; this is what makes
+ * algorithms like std::sort or std::partition work on multi array views. */
+template<typename... Ts>
+class multi_array_ref : public std::tuple<Ts &...>
+{
+	using base = std::tuple<Ts &...>;
+	using indices = std::index_sequence_for<Ts...>;
+
+public:
+	using value_type = std::tuple<std::remove_const_t<Ts>...>;
+
+	explicit multi_array_ref(Ts &... refs) : base(refs...) {}
+
+	/* Copy constructor rebinds (copies references); all assignments assign through. */
+	multi_array_ref(const multi_array_ref &) = default;
+
+	multi_array_ref &operator=(const multi_array_ref &rhs) { assign(rhs, indices()); return *this; }
+	multi_array_ref &operator=(multi_array_ref &&rhs) { assign(std::move(rhs), indices()); return *this; }
+	multi_array_ref &operator=(const value_type &rhs) { assign(rhs, indices()); return *this; }
+	multi_array_ref &operator=(value_type &&rhs) { assign(std::move(rhs), indices()); return *this; }
+
+	/* Conversion to values; elements are moved out if proxy is an rvalue (e.g. value_type v = std::move(*it)). */
+	operator value_type() const & { return copy_out(indices()); }
+	operator value_type() && { return move_out(indices()); }
+
+	/* Swap referenced elements; proxies are passed by value, since dereferencing iterator produces temporaries. */
+	friend void swap(multi_array_ref lhs, multi_array_ref rhs)
+	{
+		lhs.swap_impl(rhs, indices());
+	}
+
+private:
+	template<typename Rhs, size_t... I>
+	void assign(Rhs &&rhs, std::index_sequence<I...>)
+	{
+		((std::get<I>(static_cast<base &>(*this)) = std::get<I>(std::forward<Rhs>(rhs))), ...);
+	}
+	template<size_t... I>
+	void assign(multi_array_ref &&rhs, std::index_sequence<I...>)
+	{
+		((std::get<I>(static_cast<base &>(*this)) = std::move(std::get<I>(static_cast<base &>(rhs)))), ...);
+	}
+
+	template<size_t... I>
+	value_type copy_out(std::index_sequence<I...>) const
+	{
+		return value_type(std::get<I>(static_cast<const base &>(*this))...);
+	}
+	template<size_t... I>
+	value_type move_out(std::index_sequence<I...>)
+	{
+		return value_type(std::move(std::get<I>(static_cast<base &>(*this)))...);
+	}
+
+	template<size_t... I>
+	void swap_impl(multi_array_ref &rhs, std::index_sequence<I...>)
+	{
+		using std::swap;
+		(swap(std::get<I>(static_cast<base &>(*this)), std::get<I>(static_cast<base &>(rhs))), ...);
+	}
+};
+
+/* Random-access iterator over rows of multi array view. Stores start pointer of every array and a single row index, so advancing touches
+ * only the index and dereferencing is plain indexed access into each array. */
+template<typename... Ts>
+class multi_array_iterator
+{
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::tuple<std::remove_const_t<Ts>...>;
+	using reference = multi_array_ref<Ts...>;
+	using pointer = void;
+	using difference_type = ptrdiff_t;
+
+	multi_array_iterator() = default;
+	multi_array_iterator(const std::tuple<Ts *...> &starts, difference_type index) : mStarts(starts), mIndex(index) {}
+
+	reference operator*() const { return deref(mIndex, std::index_sequence_for<Ts...>()); }
+	reference operator[](difference_type n) const { return deref(mIndex + n, std::index_sequence_for<Ts...>()); }
+
+	multi_array_iterator &operator++() { ++mIndex; return *this; }
+	multi_array_iterator &operator--() { --mIndex; return *this; }
+	multi_array_iterator operator++(int) { auto tmp = *this; ++mIndex; return tmp; }
+	multi_array_iterator operator--(int) { auto tmp = *this; --mIndex; return tmp; }
+
+	multi_array_iterator &operator+=(difference_type n) { mIndex += n; return *this; }
+	multi_array_iterator &operator-=(difference_type n) { mIndex -= n; return *this; }
+	friend multi_array_iterator operator+(multi_array_iterator it, difference_type n) { return it += n; }
+	friend multi_array_iterator operator+(difference_type n, multi_array_iterator it) { return it += n; }
+	friend multi_array_iterator operator-(multi_array_iterator it, difference_type n) { return it -= n; }
+	friend difference_type operator-(const multi_array_iterator &lhs, const multi_array_iterator &rhs) { return lhs.mIndex - rhs.mIndex; }
+
+	// comparisons assume both iterators belong to the same view
+	friend bool operator==(const multi_array_iterator &lhs, const multi_array_iterator &rhs) { return lhs.mIndex == rhs.mIndex; }
+	friend bool operator!=(const multi_array_iterator &lhs, const multi_array_iterator &rhs) { return lhs.mIndex != rhs.mIndex; }
+	friend bool operator<(const multi_array_iterator &lhs, const multi_array_iterator &rhs) { return lhs.mIndex < rhs.mIndex; }
+	friend bool operator>(const multi_array_iterator &lhs, const multi_array_iterator &rhs) { return lhs.mIndex > rhs.mIndex; }
+	friend bool operator<=(const multi_array_iterator &lhs, const multi_array_iterator &rhs) { return lhs.mIndex <= rhs.mIndex; }
+	friend bool operator>=(const multi_array_iterator &lhs, const multi_array_iterator &rhs) { return lhs.mIndex >= rhs.mIndex; }
+
+	/* Row index relative to the start of the view. */
+	difference_type index() const { return mIndex; }
+
+private:
+	template<size_t... I>
+	reference deref(difference_type index, std::index_sequence<I...>) const
+	{
+		return reference(std::get<I>(mStarts)[index]...);
+	}
+
+private:
+	std::tuple<Ts *...>	mStarts;
+	difference_type		mIndex = 0;
+};
+
+/* Multi array view is a non-owning range of rows over several arrays of equal size (e.g. selected parallel vector slices).
+ * Dereferencing yields multi_array_ref proxies, so it can be used with range-based for (including structured bindings) and STL algorithms. */
+template<typename... Ts>
+class multi_array_view
+{
+public:
+	using value_type = std::tuple<std::remove_const_t<Ts>...>;
+	using reference = multi_array_ref<Ts...>;
+	using iterator = multi_array_iterator<Ts...>;
+	using const_iterator = iterator;
+	using difference_type = ptrdiff_t;
+	using size_type = size_t;
+
+	/* Default constructor creates empty range. */
+	multi_array_view() = default;
+
+	/* Constructor: arrays are defined by start pointers and common size. */
+	multi_array_view(Ts *... starts, size_type size) : mStarts(starts...), mSize(size) {}
+
+	/* Note: view is shallow, its constness does not affect constness of elements (use view of const arrays for read-only access). */
+	reference operator[](size_type pos) const { return begin()[static_cast<difference_type>(pos)]; }
+	reference front() const { return *begin(); }
+	reference back() const { return *(end() - 1); }
+
+	iterator begin() const { return iterator(mStarts, 0); }
+	iterator end() const { return iterator(mStarts, static_cast<difference_type>(mSize)); }
+
+	bool empty() const { return mSize == 0; }
+	size_type size() const { return mSize; }
+
+	/* Access single array of the view. */
+	template<size_t Index> auto slice() const
+	{
+		return make_array_view(std::get<Index>(mStarts), mSize);
+	}
+
+private:
+	std::tuple<Ts *...>	mStarts;
+	size_type			mSize = 0;
+};
+
+/* Utility to create multi array view from common size and start pointers. */
+template<typename... Ts> multi_array_view<Ts...> make_multi_array_view(size_t size, Ts *... starts)
+{
+	return multi_array_view<Ts...>(starts..., size);
+}
+
+}
+
+/* Structured bindings support for row proxies: auto [a, b] = *it; binds references to elements. */
+namespace std {
+	template<typename... Ts>
+	struct tuple_size<utl::multi_array_ref<Ts...>> : std::integral_constant<size_t, sizeof...(Ts)> {};
+
+	template<size_t I, typename... Ts>
+	struct tuple_element<I, utl::multi_array_ref<Ts...>> : std::tuple_element<I, std::tuple<Ts &...>> {};
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "parallel_vector.h"
+#include "work_stealing_pool.h"
+
+#include <tuple>
+#include <utility>
+
+namespace utl {
+
+/* Assumed cache line size, used to keep parallel chunks from sharing lines. */
+static const constexpr size_t cache_line_size = 64;
+
+/* Contiguous range of rows [first, last) of a parallel vector, giving access to the subset of its slices requested by parallel_for.
+ * get<K>() returns the view of K-th requested slice (i.e. position in the list of requested indices, not slice index) restricted to the chunk rows. */
+template<typename... Views>
+class slice_chunk
+{
+public:
+	slice_chunk(size_t first, size_t last, Views... views) : mFirst(first), mLast(last), mViews(views...) {}
+
+	/* Row range of the chunk in the parallel vector. */
+	size_t first() const { return mFirst; }
+	size_t last() const { return mLast; }
+	size_t size() const { return mLast - mFirst; }
+
+	/* Requested slice restricted to the chunk. */
+	template<size_t K> auto get() const
+	{
+		return std::get<K>(mViews);
+	}
+
+private:
+	size_t				mFirst;
+	size_t				mLast;
+	std::tuple<Views...> mViews;
+};
+
+namespace detail {
+	/* Row granularity such that row boundary at any multiple of it falls on a cache line boundary (relative to slice start) in every slice. */
+	template<typename... Types>
+	struct cache_line_rows
+	{
+		static const constexpr size_t value = std::max({ size_t(1), (cache_line_size / std::min(cache_line_size, sizeof(Types) & (0 - sizeof(Types))))... });
+	};
+
+	template<typename Vec, typename Func, typename Executor, size_t... Indices>
+	void parallel_for_impl(Vec &vec, size_t grain, Func &f, Executor &executor, std::index_sequence<Indices...>)
+	{
+		using types = typename std::decay_t<Vec>::types;
+		static const constexpr size_t kRowsPerLine = cache_line_rows<type_list_element_t<Indices, types>...>::value;
+
+		// round grain up to cache line multiple, so that no two chunks share a line of any slice
+		size_t size = vec.size();
+		grain = std::max<size_t>(grain, 1);
+		grain = (grain + kRowsPerLine - 1) / kRowsPerLine * kRowsPerLine;
+		size_t numChunks = (size + grain - 1) / grain;
+
+		auto run = [&](auto *... starts) {
+			using chunk_type = slice_chunk<array_view<std::remove_pointer_t<decltype(starts)>>...>;
+			executor.bulk_execute(numChunks, [&](size_t chunk) {
+				size_t first = chunk * grain;
+				size_t last = std::min(size, first + grain);
+				f(chunk_type(first, last, make_array_view(starts + first, last - first)...));
+			});
+		};
+		run(vec.template slice<Indices>().data()...);
+	}
+
+	template<typename Vec, size_t... Indices>
+	struct parallel_for_indices
+	{
+		using type = std::index_sequence<Indices...>;
+	};
+
+	template<typename Vec>
+	struct parallel_for_indices<Vec>
+	{
+		using type = std::make_index_sequence<std::decay_t<Vec>::num_slices>;
+	};
+}
+
+/* Process rows of parallel vector in parallel: row range is split into chunks of (approximately) grain rows, each chunk is passed to f as slice_chunk.
+ * Indices select slices visible to the functor (all slices if empty). Executor should satisfy the concept described in work_stealing_pool.h.
+ * Chunk boundaries are rounded so that no two chunks touch the same cache line of any selected slice, provided that slices start on cache line boundary
+ * (use aligned_parallel_vector_traits<cache_line_size> or larger); with natural alignment only the first and last line of each chunk can be shared. */
+template<size_t... Indices, typename Vec, typename Func, typename Executor>
+void parallel_for(Vec &vec, size_t grain, Func &&f, Executor &executor)
+{
+	detail::parallel_for_impl(vec, grain, f, executor, typename detail::parallel_for_indices<Vec, Indices...>::type());
+}
+
+/* Same as above, using process-wide work-stealing pool. */
+template<size_t... Indices, typename Vec, typename Func>
+void parallel_for(Vec &vec, size_t grain, Func &&f)
+{
+	parallel_for<Indices...>(vec, grain, std::forward<Func>(f), work_stealing_pool::instance());
+}
+
+}
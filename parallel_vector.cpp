@@ -1,8 +1,34 @@
+// tests use assert, so keep it enabled in release builds
+#undef NDEBUG
+
+#include "arena_traits.h"
 #include "array_view.h"
+#include "column_kernels.h"
+#include "concurrent_parallel_vector.h"
+#include "handle_parallel_vector.h"
+#include "huge_page_traits.h"
+#include "mapped_parallel_vector.h"
+#include "parallel_for.h"
 #include "parallel_vector.h"
+#include "parallel_vector_gather.h"
+#include "parallel_vector_sort.h"
+#include "segmented_parallel_vector.h"
+#include "snapshot_parallel_vector.h"
+#include "stats_traits.h"
 #include "strong_typedef.h"
+#include "tiled_parallel_vector.h"
+#include "tracked_parallel_vector.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -48,6 +74,804 @@ void testArrayView()
 	v2[0] = 4;
 }
 
+/* Exercise modifiers; vectors are copied from passed empty prototype to use the same traits. */
+template<typename Vec>
+void testModifiers(const Vec &empty)
+{
+	Vec vec = empty;
+	for (int i = 0; i < 1000; ++i)
+		vec.push_back(i, std::to_string(i), i * 0.5);
+
+	vec.erase(100, 200);
+	assert(vec.size() == 900 && vec.template slice<0>()[100] == 200 && vec.template slice<1>()[100] == "200");
+
+	Vec other = empty;
+	other.push_back(-1, "a", -1.0);
+	other.push_back(-2, "b", -2.0);
+	vec.insert_copy(10, other, 0, 2);
+	assert(vec.size() == 902 && vec.template slice<0>()[11] == -2 && vec.template slice<1>()[12] == "10" && other.size() == 2);
+	vec.insert_move(0, other, 1, 2);
+	assert(vec.template slice<1>()[0] == "b" && other.size() == 1);
+
+	assert(vec.template erase_if<0>([](int x) { return x < 0; }) == 3);
+	std::vector<bool> mask(vec.size());
+	mask[0] = mask[5] = true;
+	assert(vec.erase_mask(mask) == 2 && vec.template slice<0>()[0] == 1 && vec.template slice<0>()[4] == 6);
+	bool maskRejected = false;
+	try { vec.erase_mask(mask); } catch (const std::invalid_argument &) { maskRejected = true; }
+	assert(maskRejected && vec.size() == mask.size() - 2);
+
+	int keys[] = { 5, 4, 3 };
+	std::string names[] = { "x", "y", "z" };
+	double values[] = { 0.5, 0.25, 0.125 };
+	vec.append_columns(keys, names, values);
+	utl::stable_sort_by<0>(vec);
+	for (size_t i = 1; i < vec.size(); ++i)
+		assert(vec.template slice<0>()[i - 1] <= vec.template slice<0>()[i]);
+	assert(vec.template slice<1>()[2] == "3" && vec.template slice<1>()[3] == "z" && vec.template slice<1>()[6] == "x");
+
+	vec.resize(10);
+	vec.resize(20);
+	assert(vec.size() == 20 && vec.template slice<0>()[19] == 0 && vec.template slice<1>()[19].empty());
+
+	Vec copy = vec;
+	Vec moved = std::move(copy);
+	assert(moved.size() == 20 && copy.empty() && moved.template slice<1>()[0] == vec.template slice<1>()[0]);
+
+	Vec unordered = empty;
+	for (int i = 0; i < 10; ++i)
+		unordered.push_back(i, std::to_string(i), i * 0.5);
+	unordered.swap_remove(2);
+	unordered.swap_remove(8);
+	assert(unordered.size() == 8 && unordered.template slice<0>()[2] == 9 && unordered.template slice<1>()[2] == "9" && unordered.template slice<2>()[7] == 3.5);
+	// rows: 0 1 9 3 4 5 6 7; erase 7 (tail), 1 and 4 (holes filled by 5 and 6)
+	std::vector<size_t> erased = { 7, 1, 4 };
+	auto moves = unordered.unordered_erase(erased);
+	assert(unordered.size() == 5 && moves.size() == 2 && moves[0].first == 5 && moves[0].second == 1 && moves[1].first == 6 && moves[1].second == 4);
+	int expected[] = { 0, 5, 9, 3, 6 };
+	for (int i = 0; i < 5; ++i)
+		assert(unordered.template slice<0>()[i] == expected[i] && unordered.template slice<1>()[i] == std::to_string(expected[i]));
+	bool threw = false;
+	try { unordered.unordered_erase(std::vector<size_t>{ 1, 1 }); } catch (const std::invalid_argument &) { threw = true; }
+	assert(threw && unordered.size() == 5);
+	// indices that would alias valid rows if narrowed to size_type first
+	for (int64_t bad : { int64_t((1ull << 32) + 3), int64_t(-1) })
+	{
+		threw = false;
+		try { unordered.unordered_erase(std::vector<int64_t>{ 0, bad }); } catch (const std::invalid_argument &) { threw = true; }
+		assert(threw && unordered.size() == 5 && unordered.template slice<0>()[3] == 3);
+	}
+	threw = false;
+	try { unordered.unordered_erase(std::vector<uint64_t>{ (1ull << 32) + 3 }); } catch (const std::invalid_argument &) { threw = true; }
+	assert(threw && unordered.size() == 5);
+}
+
+/* Type whose copy & move throw after given number of successful calls (negative: never). */
+struct fragile
+{
+	static int budget;
+	std::string value;
+
+	fragile(std::string v) : value(std::move(v)) {}
+	fragile(const fragile &rhs) : value(rhs.value) { spend(); }
+	fragile(fragile &&rhs) : value(std::move(rhs.value)) { spend(); }
+	fragile &operator=(const fragile &rhs) = default;
+	fragile &operator=(fragile &&rhs) = default;
+
+	static void spend()
+	{
+		if (budget-- == 0)
+			throw std::runtime_error("fragile");
+	}
+};
+int fragile::budget = -1;
+
+template<typename Vec>
+void testStrongGuarantee()
+{
+	// every possible failure point of a reallocating insert leaves vector intact
+	for (int failAt = 0; ; ++failAt)
+	{
+		Vec vec, src;
+		for (int i = 0; i < 10; ++i)
+			vec.push_back(i, fragile(std::to_string(i)));
+		for (int i = 0; i < 20; ++i)
+			src.push_back(100 + i, fragile("x"));
+
+		fragile::budget = failAt;
+		bool threw = false;
+		try
+		{
+			vec.insert_copy(3, src, 0, 20);
+		}
+		catch (const std::runtime_error &)
+		{
+			threw = true;
+		}
+		fragile::budget = -1;
+
+		if (!threw)
+		{
+			assert(vec.size() == 30 && vec.template slice<0>()[3] == 100 && vec.template slice<1>()[23].value == "3");
+			break;
+		}
+		assert(vec.size() == 10);
+		for (int i = 0; i < 10; ++i)
+			assert(vec.template slice<0>()[i] == i && vec.template slice<1>()[i].value == std::to_string(i));
+	}
+}
+
+/* Owning type opted into trivial relocation, whose copy can throw. */
+struct relocatable_fragile
+{
+	std::unique_ptr<int> value;
+
+	relocatable_fragile(int v) : value(std::make_unique<int>(v)) {}
+	relocatable_fragile(const relocatable_fragile &rhs) : value(std::make_unique<int>(*rhs.value)) { fragile::spend(); }
+	relocatable_fragile(relocatable_fragile &&rhs) = default;
+	relocatable_fragile &operator=(relocatable_fragile &&rhs) = default;
+};
+
+namespace utl {
+template<> struct is_trivially_relocatable<relocatable_fragile> : std::true_type {};
+}
+
+/* No default constructor; copy throws for negative keys. */
+struct picky
+{
+	std::string value;
+	int key;
+
+	picky(int k) : value(64, 'p'), key(k) {}
+	picky(const picky &rhs) : value(rhs.value), key(rhs.key)
+	{
+		if (key < 0)
+			throw std::runtime_error("picky");
+	}
+	picky(picky &&rhs) noexcept = default;
+};
+
+void testInPlaceInsertRollback()
+{
+	// insert into spare capacity: every failure point restores all relocatable slices (memmove-shifted tails are shifted back)
+	for (int failAt = 0; ; ++failAt)
+	{
+		utl::parallel_vector<int, relocatable_fragile> vec, src;
+		vec.reserve(100);
+		for (int i = 0; i < 10; ++i)
+			vec.push_back(i, relocatable_fragile(i));
+		for (int i = 0; i < 5; ++i)
+			src.push_back(100 + i, relocatable_fragile(100 + i));
+
+		fragile::budget = failAt;
+		bool threw = false;
+		try
+		{
+			vec.insert_copy(3, src, 0, 5);
+		}
+		catch (const std::runtime_error &)
+		{
+			threw = true;
+		}
+		fragile::budget = -1;
+
+		if (!threw)
+		{
+			assert(vec.size() == 15 && *vec.slice<1>()[3].value == 100 && *vec.slice<1>()[8].value == 3 && vec.slice<0>()[14] == 9);
+			break;
+		}
+		assert(vec.size() == 10);
+		for (int i = 0; i < 10; ++i)
+			assert(vec.slice<0>()[i] == i && *vec.slice<1>()[i].value == i);
+	}
+}
+
+/* Growth policy: 1.5x growth, page rounding and auto-shrink below quarter of capacity. */
+struct tuned_growth_traits : utl::default_parallel_vector_traits
+{
+	static constexpr double growth_factor = 1.5;
+	static const constexpr size_t growth_min_increment = 8;
+	static const constexpr size_t capacity_rounding = 4096;
+	static const constexpr size_t auto_shrink_divisor = 4;
+	static const constexpr size_t auto_shrink_min_bytes = 4096;
+};
+
+void testGrowthPolicy()
+{
+	utl::detail::parallel_vector_impl<utl::detail::type_list<int, double>, tuned_growth_traits> vec;
+	vec.push_back(0, 0.0);
+	assert(vec.capacity() == 8);
+	for (int i = 1; i < 100000; ++i)
+		vec.push_back(i, i * 0.5);
+	size_t bytes = vec.capacity() * (sizeof(int) + sizeof(double));
+	assert(vec.capacity() < 150000 && 4096 - (bytes + 64) % 4096 < 4 * (sizeof(int) + sizeof(double)) && (vec.capacity() / 2) % 2 == 1);
+
+	vec.erase(100, vec.size());
+	assert(vec.size() == 100 && vec.capacity() < 1000 && vec.slice<1>()[99] == 49.5);
+	vec.erase(50, 51);
+	assert(vec.slice<0>()[50] == 51);
+
+	utl::parallel_vector<int, std::string> shrinking;
+	for (int i = 0; i < 1000; ++i)
+		shrinking.push_back(i, std::to_string(i));
+	shrinking.erase(10, 1000);
+	assert(shrinking.capacity() > 1000);
+	shrinking.shrink_to_fit();
+	assert(shrinking.capacity() == 10 && shrinking.slice<1>()[9] == "9");
+	shrinking.clear();
+	shrinking.shrink_to_fit();
+	assert(shrinking.capacity() == 0);
+
+	utl::huge_page_parallel_vector<float, double> huge;
+	for (int i = 0; i < 300000; ++i)
+		huge.push_back(float(i), double(i));
+	assert(huge.capacity() * sizeof(double) % (2 << 20) > (2 << 20) - 4096 - sizeof(double) * 2);
+	huge.erase(1000, huge.size());
+	huge.shrink_to_fit();
+	assert(huge.capacity() == 1000 && huge.slice<1>()[999] == 999.0);
+}
+
+void testStorage()
+{
+	testModifiers(utl::parallel_vector<int, std::string, double>());
+	testModifiers(utl::aligned_parallel_vector<64, int, std::string, double>());
+	testModifiers(utl::separate_parallel_vector<int, std::string, double>());
+	testModifiers(utl::huge_page_parallel_vector<int, std::string, double>());
+	testModifiers(utl::stats_parallel_vector<int, std::string, double>());
+	testStrongGuarantee<utl::parallel_vector<int, fragile>>();
+	testStrongGuarantee<utl::separate_parallel_vector<int, fragile>>();
+	testInPlaceInsertRollback();
+
+	utl::monotonic_arena arena;
+	testModifiers(utl::arena_parallel_vector<int, std::string, double>(arena));
+	utl::size_class_pool pool;
+	utl::pool_parallel_vector<int, float> pooled(pool);
+	for (int i = 0; i < 1000; ++i)
+		pooled.push_back(i, float(i));
+	assert(pooled.slice<1>()[999] == 999.0f);
+
+	utl::aligned_parallel_vector<64, char, double> aligned(10);
+	assert(reinterpret_cast<uintptr_t>(aligned.slice<1>().data()) % 64 == 0);
+}
+
+struct counting_traits : utl::separate_parallel_vector_traits
+{
+	struct counters { size_t allocated = 0, deallocated = 0, grows = 0, relocatedBytes = 0, shiftedBytes = 0, shiftedElements = 0; };
+	counters *c;
+
+	counting_traits(counters &c) : c(&c) {}
+	void on_allocate(size_t bytes) { c->allocated += bytes; }
+	void on_deallocate(size_t bytes) { c->deallocated += bytes; }
+	void on_grow(size_t oldCapacity, size_t newCapacity) { assert(newCapacity > oldCapacity); ++c->grows; }
+	void on_relocate(size_t bytes, size_t) { c->relocatedBytes += bytes; }
+	void on_erase_shift(size_t bytes, size_t elements) { c->shiftedBytes += bytes; c->shiftedElements += elements; }
+};
+
+/* Allocation fails while flag is set. */
+struct failing_traits : utl::default_parallel_vector_traits
+{
+	bool *fail;
+
+	failing_traits(bool &fail) : fail(&fail) {}
+	void *allocate(size_t bytes)
+	{
+		if (*fail)
+			throw std::bad_alloc();
+		return utl::default_parallel_vector_traits::allocate(bytes);
+	}
+};
+
+/* Separately allocated slices; allocation fails once budget of successful allocations is spent (negative: never). */
+struct failing_separate_traits : utl::separate_parallel_vector_traits
+{
+	int *budget;
+
+	failing_separate_traits(int &budget) : budget(&budget) {}
+	void *allocate(size_t bytes)
+	{
+		if ((*budget)-- == 0)
+			throw std::bad_alloc();
+		return utl::separate_parallel_vector_traits::allocate(bytes);
+	}
+};
+
+void testInstrumentation()
+{
+	counting_traits::counters c;
+	{
+		utl::detail::parallel_vector_impl<utl::detail::type_list<int, std::string>, counting_traits> vec(c);
+		for (int i = 0; i < 100; ++i)
+			vec.push_back(i, std::to_string(i));
+		assert(c.grows > 1 && c.relocatedBytes > 0 && c.allocated > c.deallocated);
+
+		vec.erase(0, 10);
+		assert(c.shiftedElements == 90 * 2 && c.shiftedBytes == 90 * (sizeof(int) + sizeof(std::string)));
+		vec.erase_if<0>([](int v) { return v % 2 == 0; });
+		assert(vec.size() == 45 && c.shiftedElements == 90 * 2 + 45 * 2);
+	}
+	assert(c.allocated == c.deallocated);
+
+	using stats_vector = utl::stats_parallel_vector<char, short>;
+	{
+		stats_vector vec;
+		for (int i = 0; i < 1000; ++i)
+			vec.push_back(char(i), short(i));
+		stats_vector head = vec;
+		vec.insert_copy(0, head, 0, 10);
+	}
+	auto &stats = stats_vector::traits_type::stats();
+	assert(stats.grows > 0 && stats.allocations == stats.deallocations && stats.live_bytes() == 0);
+	assert(stats.bytesRelocated >= 1000 * (sizeof(char) + sizeof(short)) && stats.maxCapacity >= 1010);
+
+	std::FILE *report = std::tmpfile();
+	utl::dump_parallel_vector_stats(report);
+	assert(std::ftell(report) > 0);
+	std::fclose(report);
+}
+
+void testGatherScatter()
+{
+	// large enough to be split into parallel chunks
+	utl::parallel_vector<int, double, std::string> src;
+	for (int i = 0; i < 100000; ++i)
+		src.push_back(i, i * 0.5, std::to_string(i));
+	std::vector<uint32_t> indices;
+	for (uint32_t i = 0; i < src.size(); i += 3)
+		indices.push_back(src.size() - 1 - i);
+
+	auto all = utl::gather(src, indices);
+	assert(all.size() == indices.size());
+	for (size_t i = 0; i < indices.size(); ++i)
+		assert(all.slice<0>()[i] == int(indices[i]) && all.slice<1>()[i] == indices[i] * 0.5 && all.slice<2>()[i] == std::to_string(indices[i]));
+
+	int64_t smallIndices[] = { 5, 1, 5 };
+	auto subset = utl::gather<2, 1>(src, smallIndices);
+	static_assert(std::is_same<decltype(subset), utl::parallel_vector<std::string, double>>::value, "Gathered subset should keep slice order");
+	assert(subset.size() == 3 && subset.slice<0>()[2] == "5" && subset.slice<1>()[1] == 0.5);
+
+	for (auto &x : all.slice<1>())
+		x = -x;
+	all.slice<2>()[0] = "changed";
+	std::vector<uint32_t> positions(all.size());
+	std::iota(positions.begin(), positions.end(), 0u);
+	auto changes = utl::gather<1, 2>(all, positions);
+	utl::scatter<1, 2>(src, indices, changes);
+	assert(src.slice<1>()[src.size() - 1] == -0.5 * (src.size() - 1) && src.slice<2>()[src.size() - 1] == "changed" && src.slice<1>()[src.size() - 2] == (src.size() - 2) * 0.5);
+	assert(src.slice<0>()[src.size() - 1] == int(src.size() - 1));
+
+	bool threw = false;
+	try { utl::scatter(src, smallIndices, all); } catch (const std::invalid_argument &) { threw = true; }
+	assert(threw);
+
+	// rows are copy-constructed (no default constructor needed); a throwing copy in any parallel chunk destroys everything gathered
+	utl::parallel_vector<int, picky> pickySrc;
+	for (int i = 0; i < 100000; ++i)
+		pickySrc.push_back(i, i == 90000 ? -1 : i);
+	auto pickySubset = utl::gather<1>(pickySrc, smallIndices);
+	assert(pickySubset.size() == 3 && pickySubset.slice<0>()[1].key == 1 && pickySubset.slice<0>()[2].value == pickySrc.slice<1>()[5].value);
+	std::vector<uint32_t> pickyRows(pickySrc.size());
+	std::iota(pickyRows.begin(), pickyRows.end(), 0u);
+	threw = false;
+	try { utl::gather(pickySrc, pickyRows); } catch (const std::runtime_error &) { threw = true; }
+	assert(threw);
+
+	// result gets a copy of source traits (stateful traits have no default constructor)
+	utl::monotonic_arena arena;
+	utl::arena_parallel_vector<int, std::string> arenaSrc(arena);
+	for (int i = 0; i < 10; ++i)
+		arenaSrc.push_back(i, std::to_string(i));
+	auto arenaSubset = utl::gather<1>(arenaSrc, smallIndices);
+	static_assert(std::is_same<decltype(arenaSubset), utl::arena_parallel_vector<std::string>>::value, "Gathered vector should keep traits type");
+	assert(arenaSubset.size() == 3 && arenaSubset.slice<0>()[0] == "5" && arenaSubset.slice<0>()[1] == "1");
+	arenaSubset.push_back("more");
+	assert(arenaSubset.size() == 4);
+}
+
+/* Compare kernel implementation against scalar reference: lengths around every vector width and unroll factor, unaligned starts.
+ * Values are small integers, so floating-point sums are exact regardless of summation order. */
+template<typename T>
+void testKernelTable(const utl::detail::kernel_table<T> &k)
+{
+	std::vector<T> buffer(1024 + 8);
+	for (size_t i = 0; i < buffer.size(); ++i)
+		buffer[i] = T(int((i * 7919) % 31) - 15);
+
+	const utl::compare_op ops[] = { utl::compare_op::less, utl::compare_op::less_equal, utl::compare_op::greater, utl::compare_op::greater_equal, utl::compare_op::equal, utl::compare_op::not_equal };
+	auto compare = [](utl::compare_op op, T a, T b) {
+		switch (op)
+		{
+		case utl::compare_op::less:				return a < b;
+		case utl::compare_op::less_equal:		return a <= b;
+		case utl::compare_op::greater:			return a > b;
+		case utl::compare_op::greater_equal:	return a >= b;
+		case utl::compare_op::equal:			return a == b;
+		case utl::compare_op::not_equal:		return a != b;
+		}
+		return false;
+	};
+
+	for (size_t offset : { 0, 1, 3 })
+	{
+		for (size_t size : { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 1003 })
+		{
+			const T *data = buffer.data() + offset;
+			assert(k.sum(data, size) == std::accumulate(data, data + size, utl::detail::sum_type_t<T>(0)));
+			if (size > 0)
+			{
+				auto minIt = std::min_element(data, data + size), maxIt = std::max_element(data, data + size);
+				assert(k.min_value(data, size) == *minIt && k.max_value(data, size) == *maxIt);
+				assert(k.argmin(data, size) == size_t(minIt - data) && k.argmax(data, size) == size_t(maxIt - data));
+			}
+			for (auto op : ops)
+				assert(k.count_if(data, size, op, T(3)) == size_t(std::count_if(data, data + size, [&](T x) { return compare(op, x, T(3)); })));
+
+			std::vector<T> expected(size), scanned(size + 1);
+			std::partial_sum(data, data + size, expected.begin());
+			k.inclusive_scan(data, scanned.data() + 1, size, T(0));	// unaligned output too
+			assert(std::equal(expected.begin(), expected.end(), scanned.begin() + 1));
+			k.inclusive_scan(data, scanned.data(), size, T(5));
+			for (size_t i = 0; i < size; ++i)
+				assert(scanned[i] == expected[i] + T(5));
+		}
+	}
+}
+
+template<typename T>
+void testKernels()
+{
+	using namespace utl::detail;
+#define KERNEL_TABLE(ns) kernel_table<T>{ &ns::sum<T>, &ns::min_value<T>, &ns::max_value<T>, &ns::argmin<T>, &ns::argmax<T>, &ns::count_if<T>, &ns::inclusive_scan<T> }
+	testKernelTable(KERNEL_TABLE(scalar_kernels));
+#if UTL_KERNELS_X86
+	if (cpu_features::get().sse41)
+		testKernelTable(KERNEL_TABLE(sse41_kernels));
+	if (cpu_features::get().avx2)
+		testKernelTable(KERNEL_TABLE(avx2_kernels));
+#endif
+#undef KERNEL_TABLE
+
+	// public entry points on unaligned views: dispatched sum and scans, including in-place and empty
+	std::vector<T> values(1003 + 1), out(1003);
+	std::iota(values.begin(), values.end(), T(0));
+	auto in = utl::make_array_view(values.data() + 1, 1003);
+	assert(utl::kernels::sum(in) == std::accumulate(in.begin(), in.end(), sum_type_t<T>(0)));
+	utl::kernels::exclusive_scan(in, utl::make_array_view(out.data(), out.size()), T(2));
+	assert(out[0] == T(2) && out[1] == T(3) && out.back() == T(2) + T(1002 * 1003 / 2));
+	utl::kernels::exclusive_scan(utl::make_array_view(values.data(), 0), utl::make_array_view(out.data(), 0), T(0));
+	utl::kernels::inclusive_scan(in, in);
+	assert(in[0] == T(1) && in.back() == T(1003 * 1004 / 2));
+}
+
+void testSortAndKernels()
+{
+	utl::parallel_vector<float, int, std::string> vec;
+	uint32_t seed = 1;
+	for (int i = 0; i < 10000; ++i)
+	{
+		seed = seed * 1664525 + 1013904223;
+		int key = int(seed >> 20) - 2048;
+		vec.push_back(float(key) * 0.5f, key, std::to_string(key));
+	}
+
+	// permutation of separate slices allocates every new block before moving anything, so allocation failure can't tear rows apart
+	int allocationBudget = -1;
+	failing_separate_traits failingTraits(allocationBudget);
+	utl::detail::parallel_vector_impl<utl::detail::type_list<int, std::string, double>, failing_separate_traits> separate(failingTraits);
+	for (int i = 0; i < 100; ++i)
+		separate.push_back(99 - i, std::to_string(99 - i), (99 - i) * 0.5);
+	allocationBudget = 1;
+	bool threw = false;
+	try { utl::sort_by<0>(separate); } catch (const std::bad_alloc &) { threw = true; }
+	allocationBudget = -1;
+	assert(threw);
+	for (size_t i = 0; i < separate.size(); ++i)
+		assert(separate.slice<0>()[i] == int(99 - i) && separate.slice<1>()[i] == std::to_string(99 - i) && separate.slice<2>()[i] == (99 - i) * 0.5);
+	utl::sort_by<0>(separate);
+	assert(separate.slice<0>()[0] == 0 && separate.slice<1>()[0] == "0" && separate.slice<2>()[99] == 49.5);
+
+	utl::radix_sort_by<0>(vec);
+	for (size_t i = 1; i < vec.size(); ++i)
+		assert(vec.slice<1>()[i - 1] <= vec.slice<1>()[i] && vec.slice<2>()[i] == std::to_string(vec.slice<1>()[i]));
+
+	assert(utl::kernels::argmin(vec.slice<1>()) == 0 && utl::kernels::max_value(vec.slice<1>()) == vec.slice<1>().back());
+	assert(utl::kernels::count_if(vec.slice<1>(), utl::compare_op::less, 0) == size_t(std::lower_bound(vec.slice<1>().begin(), vec.slice<1>().end(), 0) - vec.slice<1>().begin()));
+
+	std::atomic<size_t> rows{ 0 };
+	utl::work_stealing_pool pool(3);
+	utl::parallel_for<0, 1>(vec, 100, [&](auto chunk) {
+		auto a = chunk.template get<0>();
+		auto b = chunk.template get<1>();
+		for (size_t i = 0; i < chunk.size(); ++i)
+			assert(a[i] == float(b[i]) * 0.5f);
+		rows += chunk.size();
+	}, pool);
+	assert(rows == vec.size());
+
+	// task exception is rethrown on calling thread after every other task has run; pool stays usable
+	std::atomic<size_t> calls{ 0 };
+	bool caught = false;
+	try
+	{
+		pool.bulk_execute(1000, [&](size_t i) {
+			++calls;
+			if (i == 500)
+				throw std::runtime_error("task");
+		});
+	}
+	catch (const std::runtime_error &)
+	{
+		caught = true;
+	}
+	assert(caught && calls == 1000);
+	pool.bulk_execute(10, [&](size_t) { ++calls; });
+	assert(calls == 1010);
+
+	auto view = vec.view<1, 2>();
+	std::sort(view.begin(), view.end(), [](const auto &l, const auto &r) { return std::get<0>(l) > std::get<0>(r); });
+	assert(vec.slice<1>()[0] >= vec.slice<1>()[1] && vec.slice<2>()[0] == std::to_string(vec.slice<1>()[0]));
+}
+
+void testOtherContainers()
+{
+	utl::segmented_parallel_vector<int, std::string> segmented;
+	segmented.push_back(0, "0");
+	const int *first = &segmented.get<0>(0);
+	for (int i = 1; i < 40000; ++i)
+		segmented.push_back(i, std::to_string(i));
+	assert(first == &segmented.get<0>(0) && segmented.get<std::string>(39999) == "39999");
+
+	// stateful traits without default constructor: every chunk allocates from the pool
+	utl::size_class_pool chunkPool;
+	utl::detail::segmented_parallel_vector_impl<utl::detail::type_list<int, double>, utl::pool_parallel_vector_traits, 100> pooledChunks(chunkPool);
+	pooledChunks.reserve(1000);
+	for (int i = 0; i < 250; ++i)
+		pooledChunks.push_back(i, i * 0.5);
+	pooledChunks.shrink_to_fit();
+	assert(pooledChunks.capacity() == 300 && pooledChunks.get<1>(249) == 124.5);
+
+	// auto-shrinking traits don't apply to chunks or to tracked rows: removal never moves remaining rows
+	utl::detail::segmented_parallel_vector_impl<utl::detail::type_list<int, double>, tuned_growth_traits, 5000> shrinkingChunks;
+	for (int i = 0; i < 5000; ++i)
+		shrinkingChunks.push_back(i, i * 0.5);
+	const double *kept = &shrinkingChunks.get<1>(10);
+	while (shrinkingChunks.size() > 11)
+		shrinkingChunks.pop_back();
+	assert(kept == &shrinkingChunks.get<1>(10) && shrinkingChunks.chunk(0).capacity() == 5000);
+	utl::detail::tracked_parallel_vector_impl<utl::detail::type_list<int, double>, tuned_growth_traits, 1024> shrinkingTracked;
+	shrinkingTracked.reserve(5000);
+	for (int i = 0; i < 5000; ++i)
+		shrinkingTracked.push_back(i, i * 0.5);
+	kept = &shrinkingTracked.get<1>(10);
+	shrinkingTracked.erase(11, 5000);
+	assert(kept == &shrinkingTracked.get<1>(10) && shrinkingTracked.capacity() >= 5000);
+
+	utl::tiled_parallel_vector<8, float, double> tiled;
+	for (int i = 0; i < 100; ++i)
+		tiled.push_back(float(i), i * 2.0);
+	size_t rows = 0;
+	tiled.for_each_tile([&](auto a, auto b) { rows += a.size(); assert(b[0] == a[0] * 2.0); });
+	assert(rows == 100 && tiled.get<1>(99) == 198.0);
+
+	// growth follows traits policy, in whole tiles: 8 rows minimum increment, 1.5x, blocks filled up to page boundary
+	utl::detail::tiled_parallel_vector_impl<utl::detail::type_list<int, double>, tuned_growth_traits, 8> tunedTiles;
+	tunedTiles.push_back(0, 0.0);
+	assert(tunedTiles.capacity() == 8);
+	for (int i = 1; i < 100000; ++i)
+		tunedTiles.push_back(i, i * 0.5);
+	size_t tileBlockBytes = tunedTiles.capacity() / 8 * decltype(tunedTiles)::tile_bytes;
+	assert(tunedTiles.capacity() % 8 == 0 && tunedTiles.capacity() < 150000 && 4096 - (tileBlockBytes + 64) % 4096 < decltype(tunedTiles)::tile_bytes);
+	assert(tunedTiles.get<1>(99999) == 49999.5);
+
+	utl::snapshot_parallel_vector<int, std::string> published;
+	published.reserve(100);
+	for (int i = 0; i < 10; ++i)
+		published.push_back(i, std::to_string(i));
+	assert(published.snapshot().empty() && published.publish() == 1);
+	auto older = published.snapshot();
+	published.push_back(10, "10");		// appends into spare capacity, no copy
+	published.write<0>(3) = -3;			// clones int column only
+	published.publish();
+	auto newer = published.snapshot();
+	assert(older.size() == 10 && older.get<0>(3) == 3 && newer.size() == 11 && newer.get<0>(3) == -3);
+	assert(older.slice<1>().data() == newer.slice<1>().data() && older.slice<0>().data() != newer.slice<0>().data());
+	published.erase(0, 5);
+	published.clear();
+	assert(older.get<std::string>(9) == "9" && newer.get<std::string>(10) == "10" && published.snapshot().size() == 11);
+
+	// readers always see consistent versions while writer keeps mutating
+	utl::snapshot_parallel_vector<int, int> pairs;
+	for (int i = 0; i < 1000; ++i)
+		pairs.push_back(0, 0);
+	pairs.publish();
+	std::atomic<bool> done{ false };
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 2; ++t)
+		readers.emplace_back([&] {
+			while (!done.load())
+			{
+				auto snap = pairs.snapshot();
+				int expected = snap.get<0>(0);
+				for (size_t i = 0; i < snap.size(); ++i)
+					assert(snap.get<0>(i) == expected && snap.get<1>(i) == -expected);
+			}
+		});
+	for (int v = 1; v <= 200; ++v)
+	{
+		for (auto &x : pairs.write_slice<0>())
+			x = v;
+		for (auto &x : pairs.write_slice<1>())
+			x = -v;
+		if (v % 2)
+			pairs.push_back(v, -v);
+		pairs.publish();
+	}
+	done = true;
+	for (auto &t : readers)
+		t.join();
+
+	utl::tracked_parallel_vector<int, float> tracked;
+	for (int i = 0; i < 5000; ++i)
+		tracked.push_back(i, float(i));
+	auto checkpoint = tracked.version();
+	assert(tracked.changed_chunks<0>(checkpoint).empty() && tracked.num_chunks() == 5);
+	tracked.write<0>(1500) = -1;
+	tracked.write_range<float>(3000, 4100)[0] = -2.0f;
+	assert((tracked.changed_chunks<0>(checkpoint) == std::vector<size_t>{ 1 }) && (tracked.changed_chunks<1>(checkpoint) == std::vector<size_t>{ 2, 3, 4 }));
+	assert(tracked.get<0>(1500) == -1 && tracked.get<float>(3000) == -2.0f && tracked.chunk_version<0>(0) <= checkpoint);
+	checkpoint = tracked.version();
+	tracked.swap_remove(10);
+	size_t changedRows = 0;
+	tracked.for_each_changed_chunk<1>(checkpoint, [&](uint32_t first, uint32_t last) { changedRows += last - first; });
+	assert(tracked.size() == 4999 && tracked.get<0>(10) == 4999 && changedRows == 1024 + 903);
+	checkpoint = tracked.version();
+	tracked.erase(4500, 4999);
+	assert((tracked.changed_chunks<0>(checkpoint) == std::vector<size_t>{ 4 }));
+
+	using handle_vec = utl::handle_parallel_vector<int, std::string>;
+	handle_vec handles;
+	std::vector<handle_vec::handle> issued;
+	for (int i = 0; i < 10; ++i)
+		issued.push_back(handles.insert(i, std::to_string(i)));
+	assert(handles.erase(issued[2]) && !handles.erase(issued[2]) && !handles.contains(issued[2]) && handles.size() == 9);
+	assert(handles.find(issued[9]) == 2 && handles.get<std::string>(issued[9]) == "9" && handles.handle_at(2) == issued[9]);
+	auto reused = handles.insert(20, "20");
+	assert(reused.slot == issued[2].slot && reused != issued[2] && handles.get<0>(reused) == 20 && !handles.contains(handle_vec::handle()));
+	for (size_t i = 0; i < handles.size(); ++i)
+		assert(handles.get<0>(handles.handle_at(i)) == handles.slice<0>()[i]);
+	handles.clear();
+	assert(handles.empty() && !handles.contains(issued[0]) && !handles.contains(reused));
+
+	STRONG_TYPEDEF(pos_x, float);
+	STRONG_TYPEDEF(pos_y, float);
+	utl::parallel_vector<utl::group<pos_x, pos_y>, std::string> grouped;
+	grouped.push_back(std::make_tuple(1.0f, 2.0f), "a");
+	grouped.push_back(std::make_tuple(3.0f, 4.0f), "b");
+	assert(float(grouped.slice<pos_y>()[1]) == 4.0f);
+	assert((grouped.slice<0, 0>().stride() == sizeof(utl::group<pos_x, pos_y>)));
+	static_assert(std::is_trivially_copyable<utl::group<pos_x, pos_y>>::value && utl::is_trivially_relocatable<utl::group<float, int>>::value);
+	static_assert(!std::is_trivially_copyable<utl::group<float, std::string>>::value);
+	auto &[firstX, firstY] = grouped.slice<0>()[0];
+	assert(float(firstX) == 1.0f && float(firstY) == 2.0f);
+	assert((utl::group<float, int>(std::make_tuple(1.0f, 2)) == utl::group<float, int>(1.0f, 2) && utl::group<float, int>() != utl::group<float, int>(0.0f, 1)));
+
+	utl::parallel_vector<int, double> source;
+	for (int i = 0; i < 1000; ++i)
+		source.push_back(i, i * 0.25);
+	const char *path = "parallel_vector_test.snapshot";
+	utl::save_snapshot(source, path);
+	{
+		utl::mapped_parallel_vector<int, double> mapped(path);
+		assert(mapped.size() == 1000 && mapped.slice<double>()[999] == 999 * 0.25);
+		utl::parallel_vector<int, double> loaded;
+		utl::load_snapshot(loaded, path);
+		assert(loaded.size() == 1000 && loaded.slice<0>()[500] == 500);
+	}
+	// corrupted row count: too large for the file, or large enough for slice sizes to wrap around to the original layout
+	for (uint64_t numRows : { uint64_t(1001), (uint64_t(1) << 62) + 1000 })
+	{
+		std::FILE *file = std::fopen(path, "r+b");
+		std::fseek(file, offsetof(utl::detail::snapshot_header, numRows), SEEK_SET);
+		std::fwrite(&numRows, sizeof(numRows), 1, file);
+		std::fclose(file);
+		bool rejected = false;
+		try
+		{
+			utl::mapped_parallel_vector<int, double> mapped(path);
+		}
+		catch (const std::runtime_error &)
+		{
+			rejected = true;
+		}
+		assert(rejected);
+	}
+	std::remove(path);
+
+	utl::concurrent_parallel_vector<int, std::string> concurrent;
+	std::vector<std::thread> producers;
+	for (int t = 0; t < 4; ++t)
+	{
+		producers.emplace_back([&concurrent, t] {
+			for (int i = t * 5000; i < (t + 1) * 5000; i += 50)
+			{
+				size_t row = concurrent.claim(50);
+				for (int k = 0; k < 50; ++k)
+					concurrent.emplace(row + k, i + k, std::to_string(i + k));
+				concurrent.publish(row, 50);
+			}
+		});
+	}
+	for (auto &producer : producers)
+		producer.join();
+	std::vector<bool> seen(20000);
+	concurrent.for_each_segment([&](auto ids, auto names) {
+		for (size_t i = 0; i < ids.size(); ++i)
+		{
+			assert(!seen[ids[i]] && names[i] == std::to_string(ids[i]));
+			seen[ids[i]] = true;
+		}
+	});
+	assert(concurrent.size() == 20000 && std::count(seen.begin(), seen.end(), true) == 20000);
+
+	// failed claims (too many rows, allocation failure) take no slots, so later rows still get published
+	bool failAllocation = false;
+	utl::detail::concurrent_parallel_vector_impl<utl::detail::type_list<int>, failing_traits, 64> bounded(failAllocation);
+	bounded.push_back(0);
+	bool rejected = false;
+	try
+	{
+		bounded.claim(bounded.max_rows);
+	}
+	catch (const std::length_error &)
+	{
+		rejected = true;
+	}
+	assert(rejected && bounded.claimed() == 1);
+	for (int i = 1; i < 64; ++i)
+		bounded.push_back(i);
+	failAllocation = true;
+	rejected = false;
+	try
+	{
+		bounded.push_back(64);
+	}
+	catch (const std::bad_alloc &)
+	{
+		rejected = true;
+	}
+	failAllocation = false;
+	assert(rejected && bounded.claimed() == 64);
+	bounded.push_back(64);
+	assert(bounded.size() == 65 && bounded.get<0>(64) == 64);
+
+	// throwing constructor: push_back claims no slot, emplace destroys already constructed part of the row
+	utl::concurrent_parallel_vector<std::string, relocatable_fragile> throwing;
+	const std::string name(100, 'x');
+	relocatable_fragile original(7);
+	throwing.push_back(name, original);
+	for (int attempt = 0; attempt < 2; ++attempt)
+	{
+		fragile::budget = 0;
+		rejected = false;
+		try
+		{
+			if (attempt == 0)
+				throwing.push_back(name, original);
+			else
+				throwing.emplace(throwing.claim(), name, original);
+		}
+		catch (const std::runtime_error &)
+		{
+			rejected = true;
+		}
+		fragile::budget = -1;
+		assert(rejected && throwing.claimed() == 1 + attempt && throwing.size() == 1);
+	}
+	throwing.emplace(1, name, 8);
+	throwing.publish(1, 1);
+	throwing.push_back(name, 9);
+	assert(throwing.size() == 3 && throwing.get<0>(2) == name && *throwing.get<1>(1).value == 8 && *throwing.get<1>(2).value == 9);
+}
+
 int main()
 {
 // 	testStrongTypedef();
@@ -95,5 +919,16 @@ int main()
 	utl::parallel_vector<std::tuple<int, char>, float> vv;
 	vv.push_back(std::make_tuple(1, 'a'), 1.0f);
 
+	testStorage();
+	testInstrumentation();
+	testGrowthPolicy();
+	testSortAndKernels();
+	testKernels<float>();
+	testKernels<double>();
+	testKernels<int32_t>();
+	testGatherScatter();
+	testOtherContainers();
+	printf("all tests passed\n");
+
 	return 0;
 }
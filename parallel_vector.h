@@ -1,62 +1,169 @@
 #pragma once
 
 #include "array_view.h"
+#include "multi_array_view.h"
+#include "strided_array_view.h"
 #include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <stdint.h>
 
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define UTL_HAS_TYPE_PACK_ELEMENT
+#endif
+#endif
+
 namespace utl {
 
+/* Type is trivially relocatable if moving an object to new location and destroying the source is equivalent to copying its bytes.
+ * Trivially copyable types are always relocatable; specialize this for other types to opt them into bulk memcpy/memmove paths.
+ * Note: whether std::string qualifies depends on the implementation - it does for MSVC & libc++, but not for libstdc++ (SSO buffer is self-referential). */
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
 namespace detail {
-	/* Simple type list class. Simplified version of STL tuple; can never be instantiated. */
+	/* Storage of group members: nested structs, so that group is trivially copyable (and relocatable, snapshot-able) whenever all members are,
+	 * which is not the case for std::tuple. */
 	template<typename... Types>
-	struct type_list
+	struct group_storage
 	{
-		static const size_t size = sizeof...(Types);
+		group_storage() = default;
+		group_storage(std::in_place_t) {}
 	};
 
-	/* Extract type with given index from the type list. */
-	template<size_t Index, typename TypeList>
-	struct type_list_element;
-
-	template<size_t Index, typename First, typename... Rest>
-	struct type_list_element<Index, type_list<First, Rest...>> : type_list_element<Index - 1, type_list<Rest...>> {};
-
 	template<typename First, typename... Rest>
-	struct type_list_element<0, type_list<First, Rest...>>
+	struct group_storage<First, Rest...>
 	{
-		using type = First;
+		First					value;
+		group_storage<Rest...>	rest;
+
+		group_storage() = default;
+		template<typename Arg, typename... Args>
+		group_storage(std::in_place_t, Arg &&arg, Args &&... args) : value(std::forward<Arg>(arg)), rest(std::in_place, std::forward<Args>(args)...) {}
 	};
 
 	template<size_t Index>
-	struct type_list_element<Index, type_list<>>
+	struct group_member
 	{
-		static_assert(Index < 0, "Index out of range");
+		template<typename Storage>
+		static auto &get(Storage &storage) { return group_member<Index - 1>::get(storage.rest); }
 	};
 
-	template<size_t Index, typename TypeList>
-	using type_list_element_t = typename type_list_element<Index, TypeList>::type;
+	template<>
+	struct group_member<0>
+	{
+		template<typename Storage>
+		static auto &get(Storage &storage) { return storage.value; }
+	};
+}
 
-	/* Find index of the unique type inside type list. */
-	template<typename Type, typename TypeList>
-	struct find_type_index;
+/* Group of fields stored interleaved in a single slice (e.g. position x/y/z that are always accessed together), while other slices stay columnar:
+ * parallel_vector<group<pos_x, pos_y, pos_z>, std::string, uint8_t>. slice<Index>() gives the whole interleaved slice, slice<Type>() or
+ * slice<Index, Member>() give strided view of single member. Members are accessible with get<I>() and structured bindings; group is constructed
+ * from member values or a tuple of them, and is trivially copyable if all members are.
+ * Note: to access members by type, they should be unique across the whole type list (use strong typedefs for e.g. float coordinates). */
+template<typename... Types>
+struct group
+{
+	group() = default;
+
+	template<typename... Args, typename = std::enable_if_t<sizeof...(Args) == sizeof...(Types) && sizeof...(Types) != 0 && (std::is_constructible<Types, Args &&>::value && ...)>>
+	group(Args &&... args) : mMembers(std::in_place, std::forward<Args>(args)...) {}
+
+	template<typename... Args>
+	group(const std::tuple<Args...> &args) : group(args, std::index_sequence_for<Args...>()) {}
+	template<typename... Args>
+	group(std::tuple<Args...> &&args) : group(std::move(args), std::index_sequence_for<Args...>()) {}
+
+	template<size_t Index> auto &get() & { return detail::group_member<Index>::get(mMembers); }
+	template<size_t Index> const auto &get() const & { return detail::group_member<Index>::get(mMembers); }
+	template<size_t Index> auto &&get() && { return std::move(detail::group_member<Index>::get(mMembers)); }
+
+	friend bool operator==(const group &l, const group &r) { return l.equal(r, std::index_sequence_for<Types...>()); }
+	friend bool operator!=(const group &l, const group &r) { return !(l == r); }
+
+private:
+	template<typename Tuple, size_t... Indices>
+	group(Tuple &&args, std::index_sequence<Indices...>) : mMembers(std::in_place, std::get<Indices>(std::forward<Tuple>(args))...) {}
+
+	template<size_t... Indices>
+	bool equal(const group &r, std::index_sequence<Indices...>) const { return ((get<Indices>() == r.template get<Indices>()) && ...); }
+
+	detail::group_storage<Types...> mMembers;
+};
 
-	template<typename Type, typename First, typename... Rest>
-	struct find_type_index<Type, type_list<First, Rest...>>
+namespace detail {
+	/* Simple type list class. Simplified version of STL tuple; can never be instantiated. */
+	template<typename... Types>
+	struct type_list
 	{
-		static const size_t value = 1 + find_type_index<Type, type_list<Rest...>>::value;
+		static const size_t size = sizeof...(Types);
 	};
 
-	template<typename Type, typename... Rest>
-	struct find_type_index<Type, type_list<Type, Rest...>>
+	/* Extract type with given index from the type list.
+	 * Non-recursive: compiler builtin if available, otherwise overload resolution against bases tagged with indices (one instantiation per list). */
+	template<size_t Index, typename T>
+	struct indexed_type
+	{
+		using type = T;
+	};
+
+	template<typename Indices, typename... Types>
+	struct indexed_types;
+
+	template<size_t... Indices, typename... Types>
+	struct indexed_types<std::index_sequence<Indices...>, Types...> : indexed_type<Indices, Types>... {};
+
+	template<size_t Index, typename T>
+	indexed_type<Index, T> select_indexed_type(const indexed_type<Index, T> &);
+
+	template<size_t Index, typename TypeList>
+	struct type_list_element;
+
+	template<size_t Index, typename... Types>
+	struct type_list_element<Index, type_list<Types...>>
 	{
-		static_assert(find_type_index<Type, type_list<Rest...>>::value == sizeof...(Rest), "Type is not unique");
-		static const size_t value = 0;
+		static_assert(Index < sizeof...(Types), "Index out of range");
+#ifdef UTL_HAS_TYPE_PACK_ELEMENT
+		using type = __type_pack_element<Index, Types...>;
+#else
+		using type = typename decltype(select_indexed_type<Index>(std::declval<indexed_types<std::index_sequence_for<Types...>, Types...>>()))::type;
+#endif
 	};
 
-	template<typename Type>
-	struct find_type_index<Type, type_list<>>
+	template<size_t Index, typename TypeList>
+	using type_list_element_t = typename type_list_element<Index, TypeList>::type;
+
+	/* Find index of the unique type inside type list; equals list size if type is not present. */
+	template<typename Type, typename TypeList>
+	struct find_type_index;
+
+	template<typename Type, typename... Types>
+	struct find_type_index<Type, type_list<Types...>>
 	{
-		static const size_t value = 0; // out-of-range
+	private:
+		static constexpr size_t find()
+		{
+			constexpr bool kMatches[] = { std::is_same_v<Type, Types>..., false };
+			size_t index = 0;
+			while (index < sizeof...(Types) && !kMatches[index])
+				++index;
+			return index;
+		}
+
+	public:
+		static_assert((size_t(std::is_same_v<Type, Types>) + ... + 0) <= 1, "Type is not unique");
+		static const constexpr size_t value = find();
 	};
 
 	/* Determine whether given type is a specialization of given template. */
@@ -66,57 +173,170 @@ namespace detail {
 	template<template<typename...> typename Template, typename... Args>
 	struct is_specialization_of<Template<Args...>, Template> : std::true_type {};
 
-	/* Apply metafunction to first N types of the type list. State can be used to store intermediate data.
-	 * Metafunction should define initial state as "initial" typedef. */
-	template<size_t N, typename State, typename Metafunc, typename... Types>
-	struct apply_to_all_impl;
+	/* Compile-time layout properties of the type list, computed with pack expansions instead of recursive instantiation.
+	 * offsets[i] is the sum of sizes of the first i types (so offsets[size] is the size of a whole row); common_size_pow2 is the largest
+	 * power-of-two that divides sizes of all types. */
+	template<size_t N>
+	constexpr std::array<size_t, N + 1> prefix_sums(const std::array<size_t, N> &values)
+	{
+		std::array<size_t, N + 1> result = {};
+		for (size_t i = 0; i < N; ++i)
+			result[i + 1] = result[i] + values[i];
+		return result;
+	}
+
+	template<typename TypeList>
+	struct type_list_layout;
 
-	template<size_t N, typename State, typename Metafunc, typename First, typename... Rest>
-	struct apply_to_all_impl<N, State, Metafunc, First, Rest...>
+	template<typename... Types>
+	struct type_list_layout<type_list<Types...>>
 	{
-		using type = typename apply_to_all_impl<N - 1, typename Metafunc::template type<State, First>, Metafunc, Rest...>::type;
+		static const constexpr std::array<size_t, sizeof...(Types) + 1> offsets = prefix_sums(std::array<size_t, sizeof...(Types)>{ { sizeof(Types)... } });
+		static const constexpr size_t sum_size = offsets[sizeof...(Types)];
+		static const constexpr size_t max_size = std::max({ size_t(0), sizeof(Types)... });
+		static const constexpr size_t min_align = std::min({ std::numeric_limits<size_t>::max(), alignof(Types)... });
+		static const constexpr size_t max_align = std::max({ size_t(0), alignof(Types)... });
+		static const constexpr size_t common_size_pow2 = std::min({ std::numeric_limits<size_t>::max(), (sizeof(Types) & (0 - sizeof(Types)))... });
 	};
 
-	template<typename State, typename Metafunc, typename... Rest>
-	struct apply_to_all_impl<0, State, Metafunc, Rest...>
+	/* Convert group to type list of its members. */
+	template<typename Group>
+	struct group_list;
+
+	template<typename... Types>
+	struct group_list<group<Types...>>
 	{
-		using type = State;
+		using type = type_list<Types...>;
 	};
 
-	template<typename Metafunc, typename TypeList, size_t N = TypeList::size>
-	struct apply_to_all;
+	/* Determine whether type is a group, and whether it is a group containing given type. */
+	template<typename T>
+	struct is_group : std::false_type {};
 
-	template<typename Metafunc, size_t N, typename... Types>
-	struct apply_to_all<Metafunc, type_list<Types...>, N> : apply_to_all_impl<N, typename Metafunc::initial, Metafunc, Types...> {};
+	template<typename... Types>
+	struct is_group<group<Types...>> : std::true_type {};
 
-	template<typename Metafunc, typename TypeList, size_t N = TypeList::size>
-	using apply_to_all_t = typename apply_to_all<Metafunc, TypeList, N>::type;
+	template<typename Type, typename T>
+	struct is_group_member : std::false_type {};
 
-	/* Metafunction: calculate sum of sizes of types of the type list. */
-	struct sum_size
-	{
-		using initial = std::integral_constant<size_t, 0>;
+	template<typename Type, typename... Types>
+	struct is_group_member<Type, group<Types...>> : std::integral_constant<bool, (std::is_same<Type, Types>::value || ...)> {};
 
-		template<typename State, typename T>
-		using type = std::integral_constant<size_t, State::value + sizeof(T)>;
-	};
+	/* Find index of the unique group in the type list that contains given type (out-of-range if there is none). */
+	template<typename Type, typename TypeList>
+	struct find_group_index;
 
-	/* Metafunctions: calculate min/max alignment of types from the type list. */
-	struct min_align
+	template<typename Type, typename... Types>
+	struct find_group_index<Type, type_list<Types...>>
 	{
-		using initial = std::integral_constant<size_t, std::numeric_limits<size_t>::max()>;
+		static constexpr size_t find()
+		{
+			constexpr bool kMatches[] = { is_group_member<Type, Types>::value..., false };
+			size_t result = sizeof...(Types);
+			for (size_t i = 0; i < sizeof...(Types); ++i)
+			{
+				if (kMatches[i] && result != sizeof...(Types))
+					return sizeof...(Types) + 1; // ambiguous
+				if (kMatches[i])
+					result = i;
+			}
+			return result;
+		}
 
-		template<typename State, typename T>
-		using type = std::integral_constant<size_t, (State::value < alignof(T)) ? State::value : alignof(T)>;
+		static const constexpr size_t value = find();
+		static_assert(value <= sizeof...(Types), "Type is a member of several groups");
 	};
-	struct max_align
+
+	/* Extract requested slice alignment from traits: Traits::slice_alignment if defined, 0 otherwise. */
+	template<typename Traits, typename = void>
+	struct traits_slice_alignment : std::integral_constant<size_t, 0> {};
+
+	template<typename Traits>
+	struct traits_slice_alignment<Traits, std::void_t<decltype(Traits::slice_alignment)>> : std::integral_constant<size_t, Traits::slice_alignment> {};
+
+	/* Extract growth policy from traits (all optional):
+	 * growth_factor: implicit growth multiplies capacity by this factor (default 2);
+	 * growth_min_increment: implicit growth adds at least this many rows (default 20);
+	 * capacity_rounding: when grown block is at least this many bytes, capacity is extended to use the block up to the next multiple
+	 *   (e.g. page or huge page size), so that the tail of the last page isn't wasted (default 0 - no rounding);
+	 * auto_shrink_divisor: when size drops below capacity / divisor after erase, capacity is reduced to what growth from current size
+	 *   would give; gap between shrink & grow thresholds avoids thrashing (default 0 - never shrink automatically);
+	 * auto_shrink_min_bytes: blocks smaller than this are never auto-shrunk (default 64 KB). */
+	template<typename Traits, typename = void>
+	struct traits_growth_factor { static constexpr double value = 2.0; };
+
+	template<typename Traits>
+	struct traits_growth_factor<Traits, std::void_t<decltype(Traits::growth_factor)>> { static constexpr double value = Traits::growth_factor; };
+
+	template<typename Traits, typename = void>
+	struct traits_growth_min_increment : std::integral_constant<size_t, 20> {};
+
+	template<typename Traits>
+	struct traits_growth_min_increment<Traits, std::void_t<decltype(Traits::growth_min_increment)>> : std::integral_constant<size_t, Traits::growth_min_increment> {};
+
+	template<typename Traits, typename = void>
+	struct traits_capacity_rounding : std::integral_constant<size_t, 0> {};
+
+	template<typename Traits>
+	struct traits_capacity_rounding<Traits, std::void_t<decltype(Traits::capacity_rounding)>> : std::integral_constant<size_t, Traits::capacity_rounding> {};
+
+	template<typename Traits, typename = void>
+	struct traits_auto_shrink_divisor : std::integral_constant<size_t, 0> {};
+
+	template<typename Traits>
+	struct traits_auto_shrink_divisor<Traits, std::void_t<decltype(Traits::auto_shrink_divisor)>> : std::integral_constant<size_t, Traits::auto_shrink_divisor> {};
+
+	template<typename Traits, typename = void>
+	struct traits_auto_shrink_min_bytes : std::integral_constant<size_t, 64 * 1024> {};
+
+	template<typename Traits>
+	struct traits_auto_shrink_min_bytes<Traits, std::void_t<decltype(Traits::auto_shrink_min_bytes)>> : std::integral_constant<size_t, Traits::auto_shrink_min_bytes> {};
+
+	/* Traits with automatic shrinking disabled, for vectors owned by containers that promise stable element addresses (e.g. segmented chunks). */
+	template<typename Traits>
+	struct no_auto_shrink_traits : Traits
 	{
-		using initial = std::integral_constant<size_t, 0>;
+		static const constexpr size_t auto_shrink_divisor = 0;
 
-		template<typename State, typename T>
-		using type = std::integral_constant<size_t, (State::value > alignof(T)) ? State::value : alignof(T)>;
+		no_auto_shrink_traits() = default;
+		no_auto_shrink_traits(const Traits &traits) : Traits(traits) {}
 	};
 
+	template<typename Traits>
+	using without_auto_shrink_t = std::conditional_t<traits_auto_shrink_divisor<Traits>::value == 0, Traits, no_auto_shrink_traits<Traits>>;
+
+	/* Extract storage policy from traits: Traits::separate_slice_allocation if defined, false (single block) otherwise. */
+	template<typename Traits, typename = void>
+	struct traits_separate_slices : std::false_type {};
+
+	template<typename Traits>
+	struct traits_separate_slices<Traits, std::void_t<decltype(Traits::separate_slice_allocation)>> : std::integral_constant<bool, Traits::separate_slice_allocation> {};
+
+	/* Determine whether traits can grow allocations in place: void *Traits::reallocate(void *ptr, size_t bytes). */
+	template<typename Traits, typename = void>
+	struct traits_has_reallocate : std::false_type {};
+
+	template<typename Traits>
+	struct traits_has_reallocate<Traits, std::void_t<decltype(std::declval<Traits &>().reallocate(std::declval<void *>(), size_t()))>> : std::true_type {};
+
+	/* Optional instrumentation hooks in traits; vector calls only the hooks that are defined, so uninstrumented traits pay nothing:
+	 * on_allocate(bytes) / on_deallocate(bytes): memory block obtained from / returned to traits (reallocate reports both).
+	 * on_grow(oldCapacity, newCapacity) / on_shrink(oldCapacity, newCapacity): capacity increased / reduced.
+	 * on_relocate(bytes, elements): existing elements moved to another place by reallocation, insertion or permutation.
+	 * on_erase_shift(bytes, elements): elements following erased rows shifted down. */
+	template<typename Traits, template<typename> class Hook, typename = void>
+	struct traits_has_hook : std::false_type {};
+
+	template<typename Traits, template<typename> class Hook>
+	struct traits_has_hook<Traits, Hook, std::void_t<Hook<Traits>>> : std::true_type {};
+
+	template<typename Traits> using on_allocate_hook = decltype(std::declval<Traits &>().on_allocate(size_t()));
+	template<typename Traits> using on_deallocate_hook = decltype(std::declval<Traits &>().on_deallocate(size_t()));
+	template<typename Traits> using on_grow_hook = decltype(std::declval<Traits &>().on_grow(size_t(), size_t()));
+	template<typename Traits> using on_shrink_hook = decltype(std::declval<Traits &>().on_shrink(size_t(), size_t()));
+	template<typename Traits> using on_relocate_hook = decltype(std::declval<Traits &>().on_relocate(size_t(), size_t()));
+	template<typename Traits> using on_erase_shift_hook = decltype(std::declval<Traits &>().on_erase_shift(size_t(), size_t()));
+
 	/* Utilities to construct/destroy single object. */
 	template<typename T, typename... Args>
 	void construct(T *mem, Args &&... args)
@@ -138,25 +358,103 @@ namespace detail {
 	{
 		mem->~T();
 	}
+	template<typename T>
+	void destroy_range(T *first, size_t count)
+	{
+		for (size_t i = 0; i < count; ++i)
+			destroy(first + i);
+	}
+
+	/* Utilities to relocate (move-construct + destroy source) range of objects; trivially relocatable types are moved with a single memcpy/memmove.
+	 * relocate_range: destination and source ranges should not overlap.
+	 * relocate_left/relocate_right: destination is below/above source, ranges may overlap, destination is uninitialized or already relocated-from. */
+	template<typename T>
+	void relocate_range(T *to, T *from, size_t count)
+	{
+		if constexpr (is_trivially_relocatable<T>::value)
+		{
+			if (count > 0)
+				std::memcpy(static_cast<void *>(to), static_cast<const void *>(from), count * sizeof(T));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				construct(to + i, std::move(from[i]));
+				destroy(from + i);
+			}
+		}
+	}
+	template<typename T>
+	void relocate_left(T *to, T *from, size_t count)
+	{
+		if constexpr (is_trivially_relocatable<T>::value)
+		{
+			if (count > 0)
+				std::memmove(static_cast<void *>(to), static_cast<const void *>(from), count * sizeof(T));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				construct(to + i, std::move(from[i]));
+				destroy(from + i);
+			}
+		}
+	}
+	template<typename T>
+	void relocate_right(T *to, T *from, size_t count)
+	{
+		if constexpr (is_trivially_relocatable<T>::value)
+		{
+			if (count > 0)
+				std::memmove(static_cast<void *>(to), static_cast<const void *>(from), count * sizeof(T));
+		}
+		else
+		{
+			for (size_t i = count; i-- > 0; )
+			{
+				construct(to + i, std::move(from[i]));
+				destroy(from + i);
+			}
+		}
+	}
+
+	/* Relocate elements so that to[i] is from[order[i]]; order should be a permutation of [0, count). */
+	template<typename T, typename SizeType>
+	void gather_relocate(T *to, T *from, const SizeType *order, size_t count)
+	{
+		if constexpr (is_trivially_relocatable<T>::value)
+		{
+			for (size_t i = 0; i < count; ++i)
+				std::memcpy(static_cast<void *>(to + i), static_cast<const void *>(from + order[i]), sizeof(T));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+				construct(to + i, std::move(from[order[i]]));
+			for (size_t i = 0; i < count; ++i)
+				destroy(from + i);
+		}
+	}
 
 	/* Call specified functor N times, passing current iteration as an argument.
 	 * Expected usage: seq_call<N>::execute([...](auto iteration) { use decltype(iteration)::value statically }). */
-	template<size_t N, size_t I = 0>
+	template<size_t N>
 	struct seq_call
 	{
 		template<typename Func>
 		static void execute(Func &&f)
 		{
-			f(std::integral_constant<size_t, I>());
-			seq_call<N, I + 1>::execute(std::forward<Func>(f));
+			execute_impl(f, std::make_index_sequence<N>());
 		}
-	};
 
-	template<size_t N>
-	struct seq_call<N, N>
-	{
-		template<typename Func>
-		static void execute(Func &&f) {}
+	private:
+		template<typename Func, size_t... I>
+		static void execute_impl(Func &f, std::index_sequence<I...>)
+		{
+			(f(std::integral_constant<size_t, I>()), ...);
+		}
 	};
 
 
@@ -165,53 +463,89 @@ namespace detail {
 	 * This means that i-th slice start pointer is offset by N * sum(sizeof(Tj) for j in [0,i)) from memory block start, where N is num reserved elements (capacity).
 	 * The sum is compile-time constant.
 	 * Note: you should avoid power-of-two capacities, since it can cause aliasing problems when accessing elements from different slices with same indices.
+	 * Note: every slice starts at slice_alignment boundary (natural alignment by default, or Traits::slice_alignment if larger); this is achieved by rounding capacity
+	 * to compile-time increment, so that no padding between slices is needed. Traits::allocate is expected to return memory with at least that alignment.
 	 * Note: we derive privately from traits to invoke EBCO in common cases.
+	 * Alternatively, traits can request separate allocation for each slice (separate_slice_allocation = true). Then slices are grown independently,
+	 * trivially relocatable slices are grown with Traits::reallocate if available (realloc/mremap, often without copying), and slice starts are staggered
+	 * by a few cache lines to avoid 4K aliasing between page-aligned blocks. Such traits should return memory aligned to slice_alignment from allocate/reallocate.
 	 * TODO: describe exception-safety.
-	 * TODO: do we need iterator? It would be quite weird and probably not very efficient... Maybe something like multi_array_view?
+	 * Note: there is no row iterator on the vector itself; use view<Indices...>() to iterate over rows of selected slices (see multi_array_view.h).
 	 * TODO: consider what kind of insertion (construction?) operations make sense and implement. */
 	template<typename TypeList, typename Traits>
 	class parallel_vector_impl : private Traits
 	{
 	public:
 		using typename Traits::size_type;
+		using types = TypeList;
+		using traits_type = Traits;
+
+		static const constexpr size_t num_slices = TypeList::size;
+
+		/* Guaranteed alignment of the start of every slice. */
+		static const constexpr size_t slice_alignment = std::max(traits_slice_alignment<Traits>::value, std::max(type_list_layout<TypeList>::max_align, size_t(1)));
+		static_assert((slice_alignment & (slice_alignment - 1)) == 0, "Slice alignment should be power-of-two");
+
+	private:
+		static const constexpr bool kSeparateSlices = traits_separate_slices<Traits>::value;
+		static const constexpr size_t kSizePerElement = type_list_layout<TypeList>::sum_size;
+
+		/* Capacity is always a multiple of this increment: slice offsets are capacity * sum of sizes of preceeding types, so it's enough for capacity * sizeof(T)
+		 * to be a multiple of slice alignment for every type. All quantities are powers of two, so the increment is simply the alignment divided by largest
+		 * power-of-two common to all type sizes. Separately allocated slices are properly aligned anyway. */
+		static const constexpr size_t kCommonSizePow2 = type_list_layout<TypeList>::common_size_pow2;
+		static const constexpr size_t kCapacityIncrement = kSeparateSlices || slice_alignment <= kCommonSizePow2 ? 1 : slice_alignment / kCommonSizePow2;
+		static_assert((kCapacityIncrement & (kCapacityIncrement - 1)) == 0, "Should always be power-of-two");
+		using memory_type = std::conditional_t<kSeparateSlices, std::array<void *, TypeList::size>, void *>;
 
-		/* Create empty vector, optionally reserving some initial space. */
+	public:
+		/* Create empty vector, optionally reserving some initial space. Stateful traits (e.g. referencing an arena) can be passed explicitly. */
 		explicit parallel_vector_impl(size_type capacity = 0)
 		{
 			reserve(capacity);
 		}
+		explicit parallel_vector_impl(const Traits &traits, size_type capacity = 0)
+			: Traits(traits)
+		{
+			reserve(capacity);
+		}
 
-		/* Copy constructor and assignment. */
+		/* Copy constructor and assignment. Copy is created with a copy of source traits; assignment keeps existing traits. */
 		parallel_vector_impl(const parallel_vector_impl &rhs)
+			: Traits(rhs.traits())
 		{
+			reserve(rhs.mSize);
 			insert_copy(0, rhs, 0, rhs.mSize);
 		}
 		parallel_vector_impl &operator=(const parallel_vector_impl &rhs)
 		{
 			clear();
+			reserve(rhs.mSize);
 			insert_copy(0, rhs, 0, rhs.mSize);
 			return *this;
 		}
 
-		/* Move constructor and assignment. */
-		parallel_vector_impl(parallel_vector_impl &&rhs)
-			: mMemory(rhs.mMemory)
+		/* Move constructor and assignment. Memory block is transferred together with traits, since only they can free it. */
+		parallel_vector_impl(parallel_vector_impl &&rhs) noexcept
+			: Traits(std::move(static_cast<Traits &>(rhs)))
+			, mMemory(rhs.mMemory)
 			, mSize(rhs.mSize)
 			, mCapacity(rhs.mCapacity)
 		{
-			rhs.mMemory = nullptr;
+			rhs.mMemory = memory_type();
 			rhs.mSize = rhs.mCapacity = 0;
 		}
 		parallel_vector_impl &operator=(parallel_vector_impl &&rhs)
 		{
 			clear();
-			deallocate(mMemory);
+			deallocate_memory();
 
+			static_cast<Traits &>(*this) = std::move(static_cast<Traits &>(rhs));
 			mMemory = rhs.mMemory;
 			mSize = rhs.mSize;
 			mCapacity = rhs.mCapacity;
 
-			rhs.mMemory = nullptr;
+			rhs.mMemory = memory_type();
 			rhs.mSize = rhs.mCapacity = 0;
 
 			return *this;
@@ -219,30 +553,58 @@ namespace detail {
 
 		// TODO: init-list ctor/assign ?
 		// TODO: iter range ctor/assign ?
-		// TODO: args to forward to Traits ctor
 
 		~parallel_vector_impl()
 		{
 			clear();
-			deallocate(mMemory);
+			deallocate_memory();
 		}
 
 		/* Access single slice of the parallel vector. It is most efficient way to iterate if you need access only to a single field. */
 		template<size_t Index> auto slice()
 		{
-			return make_array_view(slice_start<Index>(), mSize);
+			return make_aligned_array_view<slice_alignment>(slice_start<Index>(), mSize);
 		}
 		template<typename Type> auto slice()
 		{
-			return slice<find_type_index<Type, TypeList>::value>();
+			return typed_slice<Type>(*this);
 		}
 		template<size_t Index> auto slice() const
 		{
-			return make_array_view(const_slice_start<Index>(), mSize);
+			return make_aligned_array_view<slice_alignment>(const_slice_start<Index>(), mSize);
 		}
 		template<typename Type> auto slice() const
 		{
-			return slice<find_type_index<Type, TypeList>::value>();
+			return typed_slice<Type>(*this);
+		}
+
+		/* Access single member of a group slice as a strided view. */
+		template<size_t Index, size_t Member> auto slice()
+		{
+			return member_slice<Index, Member>(*this);
+		}
+		template<size_t Index, size_t Member> auto slice() const
+		{
+			return member_slice<Index, Member>(*this);
+		}
+
+		/* Access rows of selected slices (all if Indices is empty) as a random-access range of proxy tuples; usable with STL algorithms.
+		 * The view is invalidated by any operation that changes size or capacity. */
+		template<size_t... Indices> auto view()
+		{
+			return view_impl(*this, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+		template<typename First, typename... Rest> auto view()
+		{
+			return view<find_type_index<First, TypeList>::value, find_type_index<Rest, TypeList>::value...>();
+		}
+		template<size_t... Indices> auto view() const
+		{
+			return view_impl(*this, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+		template<typename First, typename... Rest> auto view() const
+		{
+			return view<find_type_index<First, TypeList>::value, find_type_index<Rest, TypeList>::value...>();
 		}
 
 		/* Reallocate (if necessary) memory block so that capacity is >= requested.
@@ -254,27 +616,15 @@ namespace detail {
 
 			// adjust capacity to avoid misalignment
 			capacity = adjust_capacity(capacity);
+			reallocate_storage(capacity, mSize, 0, nullptr);
+		}
 
-			// allocate new memory block (the only thing that can throw)
-			static const constexpr size_type kSizePerElement = apply_to_all_t<sum_size, TypeList>::value;
-			void *mem = allocate(capacity * kSizePerElement);
-
-			// move all existing elements to new block (assume nothrow move)
-			for_each_slice([this, mem, capacity](auto sliceIndex) {
-				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
-
-				auto *sliceFrom = slice_start<kSliceIndex>(mMemory, mCapacity);
-				auto *sliceTo = slice_start<kSliceIndex>(mem, capacity);
-				for (size_t i = 0; i < mSize; ++i)
-				{
-					construct(sliceTo + i, std::move(sliceFrom[i]));
-					destroy(sliceFrom + i);
-				}
-			});
-
-			deallocate(mMemory);
-			mMemory = mem;
-			mCapacity = capacity;
+		/* Reallocate memory block to the smallest capacity that fits current size; empty vector releases all memory. */
+		void shrink_to_fit()
+		{
+			size_type capacity = adjust_capacity(mSize);
+			if (capacity < mCapacity)
+				shrink_storage(capacity);
 		}
 
 		/* Clear by destroying all elements. Memory is not reclaimed. */
@@ -287,6 +637,7 @@ namespace detail {
 				for (size_t i = 0; i < mSize; ++i)
 					destroy(slice + i);
 			});
+			mSize = 0;
 		}
 
 		/* Append new element to the end. Assumes each argument is passed to corresponding type.
@@ -295,7 +646,7 @@ namespace detail {
 		void push_back(Args &&... args)
 		{
 			if (mSize == mCapacity)
-				auto_grow();
+				auto_grow(mSize + 1);
 
 			for_each_slice([this, argTuple = std::forward_as_tuple(std::forward<Args>(args)...)](auto sliceIndex) mutable {
 				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
@@ -306,6 +657,51 @@ namespace detail {
 			++mSize;
 		}
 
+		/* Append rows given as whole columns (one contiguous range per slice, e.g. array_view, std::vector or built-in array; all of the same size).
+		 * Capacity is checked once and every slice is filled in one go (memcpy for trivially copyable types). Throws std::invalid_argument on size mismatch. */
+		template<typename... Columns>
+		void append_columns(const Columns &... columns)
+		{
+			static_assert(sizeof...(Columns) == TypeList::size, "Number of columns should match number of slices");
+			const size_t sizes[] = { std::size(columns)... };
+			size_t count = sizes[0];
+			for (size_t size : sizes)
+				if (size != count)
+					throw std::invalid_argument("Column sizes mismatch");
+
+			size_type newSize = mSize + static_cast<size_type>(count);
+			if (newSize > mCapacity)
+				auto_grow(newSize);
+
+			append_columns_impl(static_cast<size_type>(count), std::make_index_sequence<TypeList::size>(), std::data(columns)...);
+			mSize = newSize;
+		}
+
+		/* Append count rows constructed directly in spare capacity: fill(slice0, slice1, ...) gets pointers to uninitialized storage for the new rows
+		 * of every slice and should construct all of them, or none if it throws (then the vector is left unchanged, except for capacity). */
+		template<typename Fill>
+		void append_uninitialized(size_type count, Fill &&fill)
+		{
+			size_type newSize = mSize + count;
+			if (newSize > mCapacity)
+				auto_grow(newSize);
+
+			append_uninitialized_impl(fill, std::make_index_sequence<TypeList::size>());
+			mSize = newSize;
+		}
+
+		/* Change number of rows; new rows are value-initialized (zeroed for trivial types). */
+		void resize(size_type size)
+		{
+			resize_impl(size, [](auto *p) { new(p) std::remove_pointer_t<decltype(p)>(); });
+		}
+
+		/* Change number of rows; new rows are default-initialized, i.e. left uninitialized for trivial types, so that producers can fill slices directly. */
+		void resize_default_init(size_type size)
+		{
+			resize_impl(size, [](auto *p) { new(p) std::remove_pointer_t<decltype(p)>; });
+		}
+
 		/* Insert elements by copying subrange from other container. */
 		template<typename Cont>
 		void insert_copy(size_type insertionPoint, Cont &&other, typename std::decay_t<Cont>::size_type begin, typename std::decay_t<Cont>::size_type end)
@@ -329,15 +725,185 @@ namespace detail {
 			size_type numRemoved = end - begin;
 			for_each_slice([&](auto sliceIndex) {
 				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+				using type = type_list_element_t<kSliceIndex, TypeList>;
 				auto *slice = slice_start<kSliceIndex>();
 				auto *sliceEnd = slice + mSize;
-				auto *firstUninit = sliceEnd - numRemoved;
-				for (auto *p = slice + begin; p < firstUninit; ++p)
-					*p = std::move(p[numRemoved]);
-				for (auto *p = firstUninit; p < sliceEnd; ++p)
-					destroy(p);
+				if constexpr (is_trivially_relocatable<type>::value)
+				{
+					// destroy erased elements and shift the tail down in one go
+					for (auto *p = slice + begin; p < slice + end; ++p)
+						destroy(p);
+					relocate_left(slice + begin, slice + end, mSize - end);
+				}
+				else
+				{
+					auto *firstUninit = sliceEnd - numRemoved;
+					for (auto *p = slice + begin; p < firstUninit; ++p)
+						*p = std::move(p[numRemoved]);
+					for (auto *p = firstUninit; p < sliceEnd; ++p)
+						destroy(p);
+				}
 			});
+			if (numRemoved > 0 && end < mSize)
+				notify_erase_shift((mSize - end) * kSizePerElement, (mSize - end) * TypeList::size);
 			mSize -= numRemoved;
+			auto_shrink();
+		}
+
+		/* Erase all rows for which predicate returns true; all slices are compacted in a single pass, preserving order.
+		 * Predicate receives const references to elements of selected slices (all slices if Indices is empty). Returns number of erased rows. */
+		template<size_t... Indices, typename Pred>
+		size_type erase_if(Pred &&pred)
+		{
+			return erase_if_impl(pred, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+
+		/* Erase all rows i for which mask[i] is true (mask can be std::vector<bool>, std::bitset, array of bools, etc.). Returns number of erased rows.
+		 * Throws std::invalid_argument if mask length differs from size. */
+		template<typename Mask>
+		size_type erase_mask(const Mask &mask)
+		{
+			if (std::size(mask) != mSize)
+				throw std::invalid_argument("Mask length should match size");
+			return compact([&mask](size_type i) { return static_cast<bool>(mask[i]); });
+		}
+
+		/* Remove single row in O(1) by moving the last row into its place; order of rows is not preserved. */
+		void swap_remove(size_type index)
+		{
+			size_type last = mSize - 1;
+			for_each_slice([&](auto sliceIndex) {
+				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+				using type = type_list_element_t<kSliceIndex, TypeList>;
+				auto *slice = slice_start<kSliceIndex>();
+				if (index == last)
+				{
+					destroy(slice + last);
+				}
+				else if constexpr (is_trivially_relocatable<type>::value)
+				{
+					destroy(slice + index);
+					relocate_range(slice + index, slice + last, 1);
+				}
+				else
+				{
+					slice[index] = std::move(slice[last]);
+					destroy(slice + last);
+				}
+			});
+			if (index != last)
+				notify_erase_shift(kSizePerElement, TypeList::size);
+			mSize = last;
+			auto_shrink();
+		}
+
+		/* Remove rows with given indices (any range of unique indices, in any order) without preserving order: holes below new size are filled
+		 * by surviving rows from the tail, in one pass per slice. Returns list of moved rows as (old index, new index) pairs; rows not listed keep their index.
+		 * Throws std::invalid_argument if an index is out of range or repeated. */
+		template<typename Indices>
+		std::vector<std::pair<size_type, size_type>> unordered_erase(const Indices &indices)
+		{
+			// range check is done on caller's index type, so that wide or negative indices can't alias valid rows after narrowing
+			std::vector<size_type> erased;
+			erased.reserve(std::distance(std::begin(indices), std::end(indices)));
+			for (const auto &index : indices)
+			{
+				using index_type = std::decay_t<decltype(index)>;
+				bool negative = false;
+				if constexpr (std::is_signed<index_type>::value)
+					negative = index < 0;
+				if (negative || std::make_unsigned_t<index_type>(index) >= mSize)
+					throw std::invalid_argument("Indices should be unique and less than size");
+				erased.push_back(static_cast<size_type>(index));
+			}
+			std::sort(erased.begin(), erased.end());
+			if (std::adjacent_find(erased.begin(), erased.end()) != erased.end())
+				throw std::invalid_argument("Indices should be unique and less than size");
+
+			// pair holes below new size with surviving tail rows
+			size_type newSize = mSize - static_cast<size_type>(erased.size());
+			auto tailErased = std::lower_bound(erased.begin(), erased.end(), newSize);
+			std::vector<std::pair<size_type, size_type>> moves;
+			moves.reserve(tailErased - erased.begin());
+			auto nextTailErased = tailErased;
+			size_type source = newSize;
+			for (auto hole = erased.begin(); hole != tailErased; ++hole, ++source)
+			{
+				for (; nextTailErased != erased.end() && *nextTailErased == source; ++nextTailErased)
+					++source;
+				moves.emplace_back(source, *hole);
+			}
+
+			for_each_slice([&](auto sliceIndex) {
+				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+				using type = type_list_element_t<kSliceIndex, TypeList>;
+				auto *slice = slice_start<kSliceIndex>();
+				if constexpr (is_trivially_relocatable<type>::value)
+				{
+					for (size_type index : erased)
+						destroy(slice + index);
+					for (auto &move : moves)
+						relocate_range(slice + move.second, slice + move.first, 1);
+				}
+				else
+				{
+					for (auto &move : moves)
+						slice[move.second] = std::move(slice[move.first]);
+					destroy_range(slice + newSize, mSize - newSize);
+				}
+			});
+			if (!moves.empty())
+				notify_erase_shift(moves.size() * kSizePerElement, moves.size() * TypeList::size);
+			mSize = newSize;
+			auto_shrink();
+			return moves;
+		}
+
+		/* Reorder rows so that new i-th row is old order[i]-th row; order should be a permutation of [0, size).
+		 * Rows are gathered slice by slice into a new memory block (sequential writes, each element is moved exactly once). Assumes nothrow move. */
+		void apply_permutation(const size_type *order)
+		{
+			if (mSize == 0)
+				return;
+
+			if constexpr (kSeparateSlices)
+			{
+				// allocate all new blocks first, so that allocation failure leaves rows intact, then gather each slice into its own block
+				std::array<void *, TypeList::size> to = {};
+				size_t numAllocated = 0;
+				try
+				{
+					for_each_slice([&](auto sliceIndex) {
+						to[decltype(sliceIndex)::value] = allocate_slice<decltype(sliceIndex)::value>(mCapacity);
+						++numAllocated;
+					});
+				}
+				catch (...)
+				{
+					free_new_storage(to, mCapacity, numAllocated, false);
+					throw;
+				}
+
+				for_each_slice([this, order, &to](auto sliceIndex) {
+					static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+					gather_relocate(static_cast<type_list_element_t<kSliceIndex, TypeList> *>(to[kSliceIndex]), slice_start<kSliceIndex>(), order, mSize);
+					deallocate_slice<kSliceIndex>();
+					mMemory[kSliceIndex] = to[kSliceIndex];
+				});
+			}
+			else
+			{
+				void *mem = allocate_block(mCapacity);
+
+				for_each_slice([this, mem, order](auto sliceIndex) {
+					static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+					gather_relocate(slice_start<kSliceIndex>(mem, mCapacity), slice_start<kSliceIndex>(mMemory, mCapacity), order, mSize);
+				});
+
+				deallocate_block(mMemory, mCapacity);
+				mMemory = mem;
+			}
+			notify_relocate(mSize * kSizePerElement, mSize * TypeList::size);
 		}
 
 		/* Erase last element. */
@@ -351,115 +917,699 @@ namespace detail {
 		size_type size() const { return mSize; }
 		size_type capacity() const { return mCapacity; }
 
+		/* Access traits instance used by this vector. */
+		const Traits &traits() const { return *this; }
+
 	private:
-		/* Heuristic to increase capacity of the memory block. */
-		void auto_grow()
+		/* Increase capacity of the memory block following traits growth policy, so that it's at least required. */
+		void auto_grow(size_type required)
 		{
-			// try to avoid having power-of-two capacities
-			reserve(std::max(2 * mCapacity + 1, mCapacity + 20));
+			reserve(grown_capacity(mCapacity, required));
 		}
 
-		/* Adjust requested capacity so that we don't misalign elements. */
-		size_type adjust_capacity(size_type required)
+		/* Capacity to grow to from given one; +1 avoids having power-of-two capacities. */
+		static size_type grown_capacity(size_type capacity, size_type required)
 		{
-			static const constexpr size_t kMinAlign = apply_to_all_t<min_align, TypeList>::value;
-			static const constexpr size_t kMaxAlign = apply_to_all_t<max_align, TypeList>::value;
-			static_assert(kMaxAlign % kMinAlign == 0, "");
+			static const constexpr size_t kMaxCapacity = std::numeric_limits<size_type>::max() - kCapacityIncrement;
+			double grown = double(capacity) * traits_growth_factor<Traits>::value + 1;
+			size_t result = std::max<size_t>(required, size_t(capacity) + traits_growth_min_increment<Traits>::value);
+			if (grown > double(result))
+				result = grown < double(kMaxCapacity) ? size_t(grown) : kMaxCapacity;
+			return round_capacity(static_cast<size_type>(std::min(result, kMaxCapacity)));
+		}
 
-			static const constexpr size_t kMinIncrement = kMaxAlign > 0 ? kMaxAlign / kMinAlign : 1;
-			static_assert((kMinIncrement & (kMinIncrement - 1)) == 0, "Should always be power-of-two");
+		/* Apply traits capacity rounding: extend capacity to use the block up to the next multiple of rounding (the largest slice's block, if slices are separate),
+		 * leaving some slack for allocator headers and slice stagger. Rounded capacity is kept an odd multiple of capacity increment, so that slices don't end up
+		 * at large power-of-two distances from each other. */
+		static size_type round_capacity(size_type capacity)
+		{
+			static const constexpr size_t kRounding = traits_capacity_rounding<Traits>::value;
+			if constexpr (kRounding > 0)
+			{
+				static const constexpr size_t kRowBytes = kSeparateSlices ? type_list_layout<TypeList>::max_size : kSizePerElement;
+				static const constexpr size_t kSlack = kSeparateSlices ? 4096 : 64;
+				size_t bytes = size_t(adjust_capacity(capacity)) * kRowBytes;
+				if (bytes >= kRounding)
+				{
+					size_t filled = ((bytes + kSlack + kRounding - 1) / kRounding * kRounding - kSlack) / kRowBytes / kCapacityIncrement;
+					if (filled % 2 == 0)
+						--filled;
+					filled *= kCapacityIncrement;
+					if (filled > capacity && filled <= std::numeric_limits<size_type>::max())
+						capacity = static_cast<size_type>(filled);
+				}
+			}
+			return capacity;
+		}
+
+		/* Adjust requested capacity so that we don't misalign elements: round it up to capacity increment. */
+		static size_type adjust_capacity(size_type required)
+		{
+			return static_cast<size_type>((required + kCapacityIncrement - 1) & ~(kCapacityIncrement - 1));
+		}
+
+		/* Reallocate storage to given capacity, which is less than current, but at least size; zero releases all memory. */
+		void shrink_storage(size_type capacity)
+		{
+			if (capacity > 0)
+			{
+				reallocate_storage(capacity, mSize, 0, nullptr);
+				return;
+			}
+			deallocate_memory();
+			mMemory = memory_type();
+			notify_shrink(mCapacity, 0);
+			mCapacity = 0;
+		}
 
-			// round up required capacity to increment
-			return (required + kMinIncrement - 1) & ~(kMinIncrement - 1);
+		/* Traits auto-shrink policy, called after erasing rows. Best effort: if smaller block can't be allocated, capacity is simply kept. */
+		void auto_shrink()
+		{
+			static const constexpr size_t kDivisor = traits_auto_shrink_divisor<Traits>::value;
+			if constexpr (kDivisor > 0)
+			{
+				if (size_t(mSize) * kDivisor >= mCapacity || size_t(mCapacity) * kSizePerElement < traits_auto_shrink_min_bytes<Traits>::value)
+					return;
+
+				size_type capacity = mSize > 0 ? adjust_capacity(grown_capacity(mSize, mSize)) : 0;
+				if (capacity >= mCapacity)
+					return;
+				try
+				{
+					shrink_storage(capacity);
+				}
+				catch (...)
+				{
+				}
+			}
 		}
 
 		/* Extract pointer to the beginning of a slice with given index. */
 		template<size_t Index>
 		static auto slice_start(void *mem, size_type capacity)
 		{
-			static const constexpr size_t kSizeCoeff = apply_to_all_t<sum_size, TypeList, Index>::value;
+			static const constexpr size_t kSizeCoeff = type_list_layout<TypeList>::offsets[Index];
 			void *sliceStart = static_cast<char *>(mem) + capacity * kSizeCoeff;
 			return static_cast<type_list_element_t<Index, TypeList> *>(sliceStart);
 		}
 		template<size_t Index>
 		static auto const_slice_start(const void *mem, size_type capacity)
 		{
-			static const constexpr size_t kSizeCoeff = apply_to_all_t<sum_size, TypeList, Index>::value;
+			static const constexpr size_t kSizeCoeff = type_list_layout<TypeList>::offsets[Index];
 			const void *sliceStart = static_cast<const char *>(mem) + capacity * kSizeCoeff;
 			return static_cast<const type_list_element_t<Index, TypeList> *>(sliceStart);
 		}
 		template<size_t Index>
 		auto slice_start()
 		{
-			return slice_start<Index>(mMemory, mCapacity);
+			if constexpr (kSeparateSlices)
+				return static_cast<type_list_element_t<Index, TypeList> *>(mMemory[Index]);
+			else
+				return slice_start<Index>(mMemory, mCapacity);
 		}
 		template<size_t Index>
 		auto const_slice_start() const
 		{
-			return const_slice_start<Index>(mMemory, mCapacity);
+			if constexpr (kSeparateSlices)
+				return static_cast<const type_list_element_t<Index, TypeList> *>(mMemory[Index]);
+			else
+				return const_slice_start<Index>(mMemory, mCapacity);
 		}
 
-		/* Execute passed functor for each slice. */
-		template<typename Func>
-		static void for_each_slice(Func &&f)
+		/* Separate slice allocation: offset of slice start from allocated block start. Large blocks are typically page-aligned, so without staggering
+		 * elements with same index in different slices would map to the same cache sets. */
+		template<size_t Index>
+		static constexpr size_t slice_stagger()
 		{
-			seq_call<TypeList::size>::execute(std::forward<Func>(f));
+			constexpr size_t kStep = slice_alignment > 64 ? slice_alignment : 64;
+			return (Index * kStep) % 4096;
+		}
+		template<size_t Index>
+		auto allocate_slice(size_type capacity)
+		{
+			using type = type_list_element_t<Index, TypeList>;
+			void *base = this->allocate(capacity * sizeof(type) + slice_stagger<Index>());
+			notify_allocate(capacity * sizeof(type) + slice_stagger<Index>());
+			return reinterpret_cast<type *>(static_cast<char *>(base) + slice_stagger<Index>());
+		}
+		template<size_t Index>
+		void deallocate_slice()
+		{
+			deallocate_slice_block<Index>(mMemory[Index], mCapacity);
+		}
+		template<size_t Index>
+		void deallocate_slice_block(void *start, size_type capacity)
+		{
+			if (start)
+			{
+				this->deallocate(static_cast<char *>(start) - slice_stagger<Index>());
+				notify_deallocate(capacity * sizeof(type_list_element_t<Index, TypeList>) + slice_stagger<Index>());
+			}
+		}
+		template<size_t Index>
+		void reallocate_slice(size_type capacity)
+		{
+			using type = type_list_element_t<Index, TypeList>;
+			static const constexpr size_t kStagger = slice_stagger<Index>();
+			char *base = mMemory[Index] ? static_cast<char *>(mMemory[Index]) - kStagger : nullptr;
+			char *newBase = static_cast<char *>(this->reallocate(base, capacity * sizeof(type) + kStagger));
+			if (base)
+				notify_deallocate(mCapacity * sizeof(type) + kStagger);
+			notify_allocate(capacity * sizeof(type) + kStagger);
+			if (base && newBase != base && mSize > 0)
+				notify_relocate(mSize * sizeof(type), mSize);
+			mMemory[Index] = newBase + kStagger;
 		}
 
-		/* Displace all existing elements starting from insertion point, fill gap with elements from other container. Transform function is used to select copy/move. */
-		template<typename Cont, typename TransformFunctor>
-		void insert_impl(size_type insertionPoint, Cont &&other, typename std::decay_t<Cont>::size_type begin, typename std::decay_t<Cont>::size_type end, TransformFunctor &&transform)
+		/* Single block allocation: allocate/free block for given capacity. */
+		void *allocate_block(size_type capacity)
 		{
-			size_type numDisplaced = mSize - insertionPoint;
-			size_type numInserted = end - begin;
-			size_type newSize = mSize + numInserted;
-			if (newSize > mCapacity)
-				reserve(newSize); // TODO: currently if we reserve, we move tail elements twice, which is wasteful
+			void *mem = this->allocate(capacity * kSizePerElement);
+			notify_allocate(capacity * kSizePerElement);
+			return mem;
+		}
+		void deallocate_block(void *mem, size_type capacity)
+		{
+			this->deallocate(mem);
+			if (mem)
+				notify_deallocate(capacity * kSizePerElement);
+		}
 
-								  // we do insertion in 3 steps:
-								  // 1. move-construct displaced elements into uninitialized memory (either until all uninitialized memory is filled, or until all elements are displaced)
-								  // 2a. if there are more elements to displace, move-assign them into vacated spots
-								  // 2b. otherwise if there remaining uninitialized memory spots, fill them by copy/move-constructing inserted elements
-								  // 3. fill remaining vacated spots by copy/move-assigning inserted elements
-			size_type numConstructedDisplaced = std::min(numDisplaced, numInserted);
-			size_type numAssignedDisplaced = numDisplaced - numConstructedDisplaced;
-			size_type numAssignedInserted = numConstructedDisplaced;
-			size_type numConstructedInserted = numInserted - numAssignedInserted;
+		/* Release all memory (elements should be destroyed already). */
+		void deallocate_memory()
+		{
+			if constexpr (kSeparateSlices)
+			{
+				for_each_slice([this](auto sliceIndex) {
+					deallocate_slice<decltype(sliceIndex)::value>();
+				});
+			}
+			else
+			{
+				deallocate_block(mMemory, mCapacity);
+			}
+		}
 
+		/* Move all rows into new storage of given capacity (at least size + gap) in a single pass, leaving a gap of gapSize rows at gapPos, which is constructed by
+		 * fill(sliceIndex, gapStart) (nullptr if there is no gap). Strong exception guarantee, following move_if_noexcept: allocation, gap construction
+		 * and copying of slices whose move can throw happen first and are undone on failure; remaining slices are relocated only after that, when nothing
+		 * can throw (except moves of non-copyable types, which are used anyway, as in std::vector). */
+		template<typename Fill>
+		void reallocate_storage(size_type capacity, size_type gapPos, size_type gapSize, Fill &&fill)
+		{
+			std::array<void *, TypeList::size> to = {};
+			void *block = nullptr;
+			const bool inPlace = gapSize == 0; // separate slices: trivially relocatable slices can be grown with Traits::reallocate
+
+			// 1. allocate new storage
+			size_t numAllocated = 0;
+			if constexpr (kSeparateSlices)
+			{
+				try
+				{
+					for_each_slice([&](auto sliceIndex) {
+						static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+						if (grows_in_place<kSliceIndex>(inPlace))
+							reallocate_slice<kSliceIndex>(capacity); // failure of later allocations leaves this slice larger than capacity, which is harmless
+						else
+							to[kSliceIndex] = allocate_slice<kSliceIndex>(capacity);
+						++numAllocated;
+					});
+				}
+				catch (...)
+				{
+					free_new_storage(to, capacity, numAllocated, inPlace);
+					throw;
+				}
+			}
+			else
+			{
+				block = allocate_block(capacity);
+				for_each_slice([&](auto sliceIndex) {
+					to[decltype(sliceIndex)::value] = slice_start<decltype(sliceIndex)::value>(block, capacity);
+				});
+				numAllocated = TypeList::size;
+			}
+
+			// 2. construct everything that can throw
+			size_t numConstructed = 0;
+			try
+			{
+				for_each_slice([&](auto sliceIndex) {
+					static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+					if (!grows_in_place<kSliceIndex>(inPlace))
+						construct_new_slice<kSliceIndex>(static_cast<type_list_element_t<kSliceIndex, TypeList> *>(to[kSliceIndex]), gapPos, gapSize, fill);
+					++numConstructed;
+				});
+			}
+			catch (...)
+			{
+				for_each_slice([&](auto sliceIndex) {
+					static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+					if (kSliceIndex < numConstructed && !grows_in_place<kSliceIndex>(inPlace))
+						destroy_new_slice<kSliceIndex>(static_cast<type_list_element_t<kSliceIndex, TypeList> *>(to[kSliceIndex]), gapPos, gapSize);
+				});
+				if constexpr (kSeparateSlices)
+					free_new_storage(to, capacity, numAllocated, inPlace);
+				else
+					deallocate_block(block, capacity);
+				throw;
+			}
+
+			// 3. relocate remaining slices & release old storage (nothrow)
 			for_each_slice([&](auto sliceIndex) {
 				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+				using type = type_list_element_t<kSliceIndex, TypeList>;
+				if (grows_in_place<kSliceIndex>(inPlace))
+					return;
 
-				auto *my = slice_start<kSliceIndex>() + newSize - 1;
-
-				for (size_type i = 0; i < numConstructedDisplaced; ++i)
+				auto *from = slice_start<kSliceIndex>();
+				auto *dst = static_cast<type *>(to[kSliceIndex]);
+				if constexpr (copy_on_grow<type>())
 				{
-					construct(my, std::move(*(my - numInserted)));
-					--my;
+					destroy_range(from, mSize);
 				}
+				else
+				{
+					relocate_range(dst, from, gapPos);
+					relocate_range(dst + gapPos + gapSize, from + gapPos, mSize - gapPos);
+				}
+				if constexpr (kSeparateSlices)
+				{
+					if (mSize > 0)
+						notify_relocate(mSize * sizeof(type), mSize);
+					deallocate_slice<kSliceIndex>();
+					mMemory[kSliceIndex] = dst;
+				}
+			});
+			if constexpr (!kSeparateSlices)
+			{
+				if (mSize > 0)
+					notify_relocate(mSize * kSizePerElement, mSize * TypeList::size);
+				deallocate_block(mMemory, mCapacity);
+				mMemory = block;
+			}
+			if (capacity > mCapacity)
+				notify_grow(mCapacity, capacity);
+			else
+				notify_shrink(mCapacity, capacity);
+			mCapacity = capacity;
+		}
 
-				for (size_type i = 0; i < numAssignedDisplaced; ++i)
+		/* Slices whose move constructor can throw are copied on growth, so that failure leaves original intact. */
+		template<typename T>
+		static constexpr bool copy_on_grow()
+		{
+			return !is_trivially_relocatable<T>::value && !std::is_nothrow_move_constructible<T>::value && std::is_copy_constructible<T>::value;
+		}
+
+		/* Separate slices: whether slice is grown in place with Traits::reallocate instead of being moved to a new block. */
+		template<size_t Index>
+		static bool grows_in_place(bool noGap)
+		{
+			return kSeparateSlices && traits_has_reallocate<Traits>::value && is_trivially_relocatable<type_list_element_t<Index, TypeList>>::value && noGap;
+		}
+
+		/* Construct gap and (for slices copied on growth) copies of existing elements in new storage of a slice; all-or-nothing. */
+		template<size_t Index, typename Fill>
+		void construct_new_slice(type_list_element_t<Index, TypeList> *to, size_type gapPos, size_type gapSize, Fill &fill)
+		{
+			using type = type_list_element_t<Index, TypeList>;
+			const type *from = slice_start<Index>();
+			size_type numPrefix = 0, numTail = 0;
+			bool gapDone = false;
+			try
+			{
+				if constexpr (copy_on_grow<type>())
+				{
+					for (; numPrefix < gapPos; ++numPrefix)
+						construct(to + numPrefix, from[numPrefix]);
+				}
+				if constexpr (!std::is_same<std::decay_t<Fill>, std::nullptr_t>::value)
 				{
-					*my = std::move(*(my - numInserted));
-					--my;
+					if (gapSize > 0)
+						fill(std::integral_constant<size_t, Index>(), to + gapPos);
 				}
+				gapDone = true;
+				if constexpr (copy_on_grow<type>())
+				{
+					for (; numTail < mSize - gapPos; ++numTail)
+						construct(to + gapPos + gapSize + numTail, from[gapPos + numTail]);
+				}
+			}
+			catch (...)
+			{
+				destroy_range(to, numPrefix);
+				if (gapDone)
+					destroy_range(to + gapPos, gapSize);
+				destroy_range(to + gapPos + gapSize, numTail);
+				throw;
+			}
+		}
+		template<size_t Index>
+		void destroy_new_slice(type_list_element_t<Index, TypeList> *to, size_type gapPos, size_type gapSize)
+		{
+			if constexpr (copy_on_grow<type_list_element_t<Index, TypeList>>())
+				destroy_range(to, mSize + gapSize);
+			else
+				destroy_range(to + gapPos, gapSize);
+		}
 
-				auto *their = other.slice<kSliceIndex>().begin() + end - 1;
-				for (size_type i = 0; i < numConstructedInserted; ++i)
+		/* Separate slices: release slices allocated by failed reallocate_storage. */
+		void free_new_storage(const std::array<void *, TypeList::size> &to, size_type capacity, size_t numAllocated, bool inPlace)
+		{
+			for_each_slice([&](auto sliceIndex) {
+				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+				if (kSliceIndex < numAllocated && !grows_in_place<kSliceIndex>(inPlace))
+					deallocate_slice_block<kSliceIndex>(to[kSliceIndex], capacity);
+			});
+		}
+
+		/* Construct count elements from source range (copy or move selected by transform); all-or-nothing. */
+		template<typename T, typename Source, typename TransformFunctor>
+		static void construct_inserted(T *to, Source *from, size_type count, TransformFunctor &transform)
+		{
+			if constexpr (std::is_trivially_copyable<T>::value && std::is_same<std::remove_const_t<Source>, T>::value)
+			{
+				if (count > 0)
+					std::memcpy(static_cast<void *>(to), static_cast<const void *>(from), count * sizeof(T));
+			}
+			else
+			{
+				size_type i = 0;
+				try
 				{
-					construct(my--, transform(*their--));
+					for (; i < count; ++i)
+						construct(to + i, transform(from[i]));
 				}
+				catch (...)
+				{
+					destroy_range(to, i);
+					throw;
+				}
+			}
+		}
 
-				for (size_type i = 0; i < numAssignedInserted; ++i)
+		/* Instrumentation: forward events to traits hooks, if defined. */
+		void notify_allocate(size_t bytes)
+		{
+			if constexpr (traits_has_hook<Traits, on_allocate_hook>::value)
+				this->on_allocate(bytes);
+		}
+		void notify_deallocate(size_t bytes)
+		{
+			if constexpr (traits_has_hook<Traits, on_deallocate_hook>::value)
+				this->on_deallocate(bytes);
+		}
+		void notify_grow(size_t oldCapacity, size_t newCapacity)
+		{
+			if constexpr (traits_has_hook<Traits, on_grow_hook>::value)
+				this->on_grow(oldCapacity, newCapacity);
+		}
+		void notify_shrink(size_t oldCapacity, size_t newCapacity)
+		{
+			if constexpr (traits_has_hook<Traits, on_shrink_hook>::value)
+				this->on_shrink(oldCapacity, newCapacity);
+		}
+		void notify_relocate(size_t bytes, size_t elements)
+		{
+			if constexpr (traits_has_hook<Traits, on_relocate_hook>::value)
+				this->on_relocate(bytes, elements);
+		}
+		void notify_erase_shift(size_t bytes, size_t elements)
+		{
+			if constexpr (traits_has_hook<Traits, on_erase_shift_hook>::value)
+				this->on_erase_shift(bytes, elements);
+		}
+
+		/* Slice with given type, or strided view of group member with given type. */
+		template<typename Type, typename Self>
+		static auto typed_slice(Self &self)
+		{
+			if constexpr (find_type_index<Type, TypeList>::value < TypeList::size)
+			{
+				return self.template slice<find_type_index<Type, TypeList>::value>();
+			}
+			else
+			{
+				static const constexpr size_t kIndex = find_group_index<Type, TypeList>::value;
+				static_assert(kIndex < TypeList::size, "Type is neither a slice nor a group member");
+				using group_type = type_list_element_t<kIndex, TypeList>;
+				return self.template slice<kIndex, find_type_index<Type, typename group_list<group_type>::type>::value>();
+			}
+		}
+
+		template<size_t Index, size_t Member, typename Self>
+		static auto member_slice(Self &self)
+		{
+			using group_type = type_list_element_t<Index, TypeList>;
+			static_assert(is_group<group_type>::value, "Slice is not a group");
+
+			auto whole = self.template slice<Index>();
+			auto *first = whole.empty() ? nullptr : &whole[0].template get<Member>();
+			return strided_array_view<std::remove_reference_t<decltype(*first)>>(first, sizeof(group_type), whole.size());
+		}
+
+		template<typename Self, size_t... Indices>
+		static auto view_impl(Self &self, std::index_sequence<Indices...>)
+		{
+			return make_multi_array_view(self.mSize, self.template slice<Indices>().data()...);
+		}
+
+		template<size_t... Indices, typename... Sources>
+		void append_columns_impl(size_type count, std::index_sequence<Indices...>, const Sources *... sources)
+		{
+			(append_column(slice_start<Indices>() + mSize, sources, count), ...);
+		}
+		template<typename Fill, size_t... Indices>
+		void append_uninitialized_impl(Fill &fill, std::index_sequence<Indices...>)
+		{
+			fill((slice_start<Indices>() + mSize)...);
+		}
+		template<typename T, typename Source>
+		static void append_column(T *to, const Source *from, size_type count)
+		{
+			if constexpr (std::is_same<T, Source>::value && std::is_trivially_copyable<T>::value)
+			{
+				if (count > 0)
+					std::memcpy(static_cast<void *>(to), static_cast<const void *>(from), count * sizeof(T));
+			}
+			else
+			{
+				for (size_type i = 0; i < count; ++i)
+					construct(to + i, from[i]);
+			}
+		}
+
+		template<typename Init>
+		void resize_impl(size_type size, Init &&init)
+		{
+			if (size <= mSize)
+			{
+				erase(size, mSize);
+				return;
+			}
+
+			if (size > mCapacity)
+				auto_grow(size);
+			for_each_slice([&](auto sliceIndex) {
+				auto *slice = slice_start<decltype(sliceIndex)::value>();
+				for (size_type i = mSize; i < size; ++i)
+					init(slice + i);
+			});
+			mSize = size;
+		}
+
+		template<typename Pred, size_t... Indices>
+		size_type erase_if_impl(Pred &pred, std::index_sequence<Indices...>)
+		{
+			auto evaluate = [&](const auto *... starts) {
+				return compact([&](size_type i) { return static_cast<bool>(pred(starts[i]...)); });
+			};
+			return evaluate(const_slice_start<Indices>()...);
+		}
+
+		/* Remove rows for which isErased(i) is true. Erased rows are evaluated once and stored as a list of surviving runs (which is usually much
+		 * smaller than the vector), then each slice is compacted independently: trivially relocatable slices move whole runs with memmove. */
+		template<typename IsErased>
+		size_type compact(IsErased &&isErased)
+		{
+			size_type firstErased = 0;
+			while (firstErased < mSize && !isErased(firstErased))
+				++firstErased;
+			if (firstErased == mSize)
+				return 0; // nothing to erase
+
+			// runs of kept rows [begin, end) after first erased row
+			std::vector<std::pair<size_type, size_type>> keptRuns;
+			for (size_type i = firstErased + 1; i < mSize; ++i)
+			{
+				if (isErased(i))
+					continue;
+				if (!keptRuns.empty() && keptRuns.back().second == i)
+					++keptRuns.back().second;
+				else
+					keptRuns.emplace_back(i, i + 1);
+			}
+
+			size_type newSize = firstErased;
+			for (auto &run : keptRuns)
+				newSize += run.second - run.first;
+
+			for_each_slice([&](auto sliceIndex) {
+				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+				using type = type_list_element_t<kSliceIndex, TypeList>;
+				auto *slice = slice_start<kSliceIndex>();
+				auto *write = slice + firstErased;
+
+				if constexpr (is_trivially_relocatable<type>::value)
+				{
+					// destroy erased rows, then relocate each surviving run down
+					size_type prevEnd = firstErased;
+					for (auto &run : keptRuns)
+					{
+						for (auto *p = slice + prevEnd; p < slice + run.first; ++p)
+							destroy(p);
+						relocate_left(write, slice + run.first, run.second - run.first);
+						write += run.second - run.first;
+						prevEnd = run.second;
+					}
+					for (auto *p = slice + prevEnd; p < slice + mSize; ++p)
+						destroy(p);
+				}
+				else
 				{
-					*my-- = transform(*their--);
+					// move-assign surviving rows over erased ones, then destroy the leftover tail
+					for (auto &run : keptRuns)
+						for (auto *p = slice + run.first; p < slice + run.second; ++p)
+							*write++ = std::move(*p);
+					for (auto *p = write; p < slice + mSize; ++p)
+						destroy(p);
 				}
 			});
 
+			if (newSize > firstErased)
+				notify_erase_shift((newSize - firstErased) * kSizePerElement, (newSize - firstErased) * TypeList::size);
+			size_type numErased = mSize - newSize;
+			mSize = newSize;
+			auto_shrink();
+			return numErased;
+		}
+
+		/* Execute passed functor for each slice. */
+		template<typename Func>
+		static void for_each_slice(Func &&f)
+		{
+			seq_call<TypeList::size>::execute(std::forward<Func>(f));
+		}
+
+		/* Displace all existing elements starting from insertion point, fill gap with elements from other container. Transform function is used to select copy/move. */
+		template<typename Cont, typename TransformFunctor>
+		void insert_impl(size_type insertionPoint, Cont &&other, typename std::decay_t<Cont>::size_type begin, typename std::decay_t<Cont>::size_type end, TransformFunctor &&transform)
+		{
+			size_type numDisplaced = mSize - insertionPoint;
+			size_type numInserted = end - begin;
+			if (numInserted == 0)
+				return;
+			size_type newSize = mSize + numInserted;
+			if (newSize > mCapacity)
+			{
+				// move prefix, inserted range and tail into the new storage in a single pass
+				reallocate_storage(adjust_capacity(grown_capacity(mCapacity, newSize)), insertionPoint, numInserted, [&](auto sliceIndex, auto *gap) {
+					construct_inserted(gap, other.template slice<decltype(sliceIndex)::value>().begin() + begin, numInserted, transform);
+				});
+				mSize = newSize;
+				return;
+			}
+
+			// we do insertion in 3 steps:
+			// 1. move-construct displaced elements into uninitialized memory (either until all uninitialized memory is filled, or until all elements are displaced)
+			// 2a. if there are more elements to displace, move-assign them into vacated spots
+			// 2b. otherwise if there remaining uninitialized memory spots, fill them by copy/move-constructing inserted elements
+			// 3. fill remaining vacated spots by copy/move-assigning inserted elements
+			size_type numConstructedDisplaced = std::min(numDisplaced, numInserted);
+			size_type numAssignedDisplaced = numDisplaced - numConstructedDisplaced;
+			size_type numAssignedInserted = numConstructedDisplaced;
+			size_type numConstructedInserted = numInserted - numAssignedInserted;
+
+			// trivially relocatable slices are restored if construction of inserted elements throws (in that slice or any later one):
+			// inserted elements are destroyed and the tail is shifted back; insert into spare capacity has strong guarantee if all slices are relocatable
+			size_t numDone = 0;
+			try
+			{
+				for_each_slice([&](auto sliceIndex) {
+					static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+					using type = type_list_element_t<kSliceIndex, TypeList>;
+
+					if constexpr (is_trivially_relocatable<type>::value)
+					{
+						// shift the tail up in one go, then construct inserted elements in the gap
+						auto *gap = slice_start<kSliceIndex>() + insertionPoint;
+						relocate_right(gap + numInserted, gap, numDisplaced);
+						try
+						{
+							construct_inserted(gap, other.template slice<kSliceIndex>().begin() + begin, numInserted, transform);
+						}
+						catch (...)
+						{
+							relocate_left(gap, gap + numInserted, numDisplaced);
+							throw;
+						}
+					}
+					else
+					{
+						auto *my = slice_start<kSliceIndex>() + newSize - 1;
+
+						for (size_type i = 0; i < numConstructedDisplaced; ++i)
+						{
+							construct(my, std::move(*(my - numInserted)));
+							--my;
+						}
+
+						for (size_type i = 0; i < numAssignedDisplaced; ++i)
+						{
+							*my = std::move(*(my - numInserted));
+							--my;
+						}
+
+						auto *their = other.template slice<kSliceIndex>().begin() + end - 1;
+						for (size_type i = 0; i < numConstructedInserted; ++i)
+						{
+							construct(my--, transform(*their--));
+						}
+
+						for (size_type i = 0; i < numAssignedInserted; ++i)
+						{
+							*my-- = transform(*their--);
+						}
+					}
+					++numDone;
+				});
+			}
+			catch (...)
+			{
+				for_each_slice([&](auto sliceIndex) {
+					static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+					if constexpr (is_trivially_relocatable<type_list_element_t<kSliceIndex, TypeList>>::value)
+					{
+						if (kSliceIndex < numDone)
+						{
+							auto *gap = slice_start<kSliceIndex>() + insertionPoint;
+							destroy_range(gap, numInserted);
+							relocate_left(gap, gap + numInserted, numDisplaced);
+						}
+					}
+				});
+				throw;
+			}
+
+			if (numDisplaced > 0)
+				notify_relocate(numDisplaced * kSizePerElement, numDisplaced * TypeList::size);
 			mSize = newSize;
 		}
 
 	private:
-		void		*mMemory	= nullptr;
+		memory_type	mMemory		= {};
 		size_type	mSize		= 0;
 		size_type	mCapacity	= 0;
 	};
@@ -470,8 +1620,9 @@ struct default_parallel_vector_traits
 {
 	using size_type = uint32_t;		// in most cases this is more than enough; using it instead of size_t allows storing size+capacity in single qword on x64
 
-	// TODO: consider factoring out allocation into separate structure (but designed better than std::allocator)
-	// TODO: alignment (note that calling aligned malloc for small alignments is very wasteful...)
+	// note: stateful allocation strategies (arenas, pools) are implemented as traits referencing an allocator object, see arena_traits.h
+	// note: alignment is only natural here, since calling aligned malloc for small alignments is very wasteful; use aligned traits if needed
+	// note: growth policy (factor, minimum increment, capacity rounding, auto-shrink) can be tuned by optional constants, see traits_growth_factor & co
 	void *allocate(size_t bytes)
 	{
 		return bytes > 0 ? ::operator new(bytes) : nullptr;
@@ -483,8 +1634,71 @@ struct default_parallel_vector_traits
 	}
 };
 
+/* Traits guaranteeing that every slice starts at given boundary (e.g. 64 for cache-line / AVX-512 aligned slices). */
+template<size_t Alignment>
+struct aligned_parallel_vector_traits : default_parallel_vector_traits
+{
+	static const constexpr size_t slice_alignment = Alignment;
+
+	void *allocate(size_t bytes)
+	{
+		return bytes > 0 ? ::operator new(bytes, std::align_val_t(Alignment)) : nullptr;
+	}
+
+	void deallocate(void *ptr)
+	{
+		::operator delete(ptr, std::align_val_t(Alignment));
+	}
+};
+
+/* Traits allocating every slice separately with malloc; trivially relocatable slices grow with realloc, which avoids copying if the block can be extended. */
+struct separate_parallel_vector_traits : default_parallel_vector_traits
+{
+	static const constexpr bool separate_slice_allocation = true;
+
+	void *allocate(size_t bytes)
+	{
+		return reallocate(nullptr, bytes);
+	}
+
+	void *reallocate(void *ptr, size_t bytes)
+	{
+		if (bytes == 0)
+		{
+			std::free(ptr);
+			return nullptr;
+		}
+		void *result = std::realloc(ptr, bytes);
+		if (!result)
+			throw std::bad_alloc();
+		return result;
+	}
+
+	void deallocate(void *ptr)
+	{
+		std::free(ptr);
+	}
+};
+
 /* Parallel vector with default traits. */
 template<typename... Types>
 using parallel_vector = detail::parallel_vector_impl<detail::type_list<Types...>, default_parallel_vector_traits>;
 
+/* Parallel vector with every slice aligned to given boundary. */
+template<size_t Alignment, typename... Types>
+using aligned_parallel_vector = detail::parallel_vector_impl<detail::type_list<Types...>, aligned_parallel_vector_traits<Alignment>>;
+
+/* Parallel vector with every slice stored in its own memory block. */
+template<typename... Types>
+using separate_parallel_vector = detail::parallel_vector_impl<detail::type_list<Types...>, separate_parallel_vector_traits>;
+
+}
+
+/* Structured bindings support for groups: auto [x, y, z] = vec.slice<0>()[i]; */
+namespace std {
+	template<typename... Types>
+	struct tuple_size<utl::group<Types...>> : std::integral_constant<size_t, sizeof...(Types)> {};
+
+	template<size_t I, typename... Types>
+	struct tuple_element<I, utl::group<Types...>> : std::tuple_element<I, std::tuple<Types...>> {};
 }
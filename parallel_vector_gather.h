@@ -0,0 +1,310 @@
+#pragma once
+
+#include "column_kernels.h"
+#include "parallel_vector.h"
+#include "work_stealing_pool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <stdint.h>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/* Gathering and scattering rows of parallel vectors by index list (e.g. output of a filter or a join).
+ * Each slice is processed separately with a tight loop over the index list: 4- and 8-byte trivially copyable slices use AVX2 hardware gather
+ * (when available at runtime and indices are 32-bit), large elements are software-prefetched a fixed distance ahead, and large index lists are split
+ * into chunks processed in parallel by an executor (see work_stealing_pool.h). Indices are not validated. */
+
+namespace utl {
+
+namespace detail {
+	/* Index lists shorter than this are processed on the calling thread; longer ones are split into chunks of this size. */
+	static const constexpr size_t kGatherChunkIndices = 16384;
+	static const constexpr size_t kParallelGatherMinIndices = 4 * kGatherChunkIndices;
+
+	/* Elements at least this large are prefetched; smaller ones are handled well enough by out-of-order execution alone. */
+	static const constexpr size_t kGatherPrefetchMinSize = 16;
+	static const constexpr size_t kGatherPrefetchDistance = 16;
+
+	inline void prefetch_read(const void *p)
+	{
+#if UTL_KERNELS_X86
+		_mm_prefetch(static_cast<const char *>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+		__builtin_prefetch(p, 0);
+#endif
+	}
+
+	inline void prefetch_write(void *p)
+	{
+#if defined(__GNUC__)
+		__builtin_prefetch(p, 1);
+#elif UTL_KERNELS_X86
+		_mm_prefetch(static_cast<const char *>(p), _MM_HINT_T0);
+#endif
+	}
+
+	/* Copy-construct to[i] from from[indices[i]] for i in [0, count); destination is uninitialized. All-or-nothing: if some copy throws,
+	 * already constructed elements are destroyed. */
+	template<bool Prefetch, typename T, typename Index>
+	void gather_slice_scalar(T *to, const T *from, const Index *indices, size_t count)
+	{
+		size_t i = 0;
+		try
+		{
+			if (Prefetch)
+				for (; i + kGatherPrefetchDistance < count; ++i)
+				{
+					prefetch_read(from + indices[i + kGatherPrefetchDistance]);
+					new(to + i) T(from[indices[i]]);
+				}
+			for (; i < count; ++i)
+				new(to + i) T(from[indices[i]]);
+		}
+		catch (...)
+		{
+			destroy_range(to, i);
+			throw;
+		}
+	}
+
+	/* to[indices[i]] = from[i] for i in [0, count). */
+	template<bool Prefetch, typename T, typename Index>
+	void scatter_slice_scalar(T *to, const T *from, const Index *indices, size_t count)
+	{
+		size_t i = 0;
+		if (Prefetch)
+			for (; i + kGatherPrefetchDistance < count; ++i)
+			{
+				prefetch_write(to + indices[i + kGatherPrefetchDistance]);
+				to[indices[i]] = from[i];
+			}
+		for (; i < count; ++i)
+			to[indices[i]] = from[i];
+	}
+
+#if UTL_KERNELS_X86
+	UTL_KERNELS_TARGET_BEGIN("avx2")
+	namespace avx2_kernels {
+		/* Hardware gather of 4-byte elements; indices are interpreted as signed, so source should have less than 2^31 elements. */
+		inline void gather_32(void *to, const void *from, const uint32_t *indices, size_t count)
+		{
+			auto *out = static_cast<int32_t *>(to);
+			auto *base = static_cast<const int *>(from);
+			size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m256i lo = _mm256_i32gather_epi32(base, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i)), 4);
+				__m256i hi = _mm256_i32gather_epi32(base, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i + 8)), 4);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), lo);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 8), hi);
+			}
+			for (; i < count; ++i)
+				out[i] = base[indices[i]];
+		}
+
+		/* Hardware gather of 8-byte elements, same restrictions as above. */
+		inline void gather_64(void *to, const void *from, const uint32_t *indices, size_t count)
+		{
+			auto *out = static_cast<int64_t *>(to);
+			auto *base = static_cast<const long long *>(from);
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256i lo = _mm256_i32gather_epi64(base, _mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i)), 8);
+				__m256i hi = _mm256_i32gather_epi64(base, _mm_loadu_si128(reinterpret_cast<const __m128i *>(indices + i + 4)), 8);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), lo);
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 4), hi);
+			}
+			for (; i < count; ++i)
+				out[i] = base[indices[i]];
+		}
+	}
+	UTL_KERNELS_TARGET_END
+#endif
+
+	/* Gather single slice chunk, picking the best available implementation. sourceSize is the size of the whole source slice. */
+	template<typename T, typename Index>
+	void gather_slice(T *to, const T *from, size_t sourceSize, const Index *indices, size_t count)
+	{
+#if UTL_KERNELS_X86
+		if constexpr (std::is_trivially_copyable<T>::value && (sizeof(T) == 4 || sizeof(T) == 8) && std::is_integral<Index>::value && sizeof(Index) == 4)
+		{
+			if (cpu_features::get().avx2 && sourceSize <= size_t(std::numeric_limits<int32_t>::max()))
+			{
+				auto *unsignedIndices = reinterpret_cast<const uint32_t *>(indices);
+				if (sizeof(T) == 4)
+					avx2_kernels::gather_32(to, from, unsignedIndices, count);
+				else
+					avx2_kernels::gather_64(to, from, unsignedIndices, count);
+				return;
+			}
+		}
+#endif
+		gather_slice_scalar<(sizeof(T) >= kGatherPrefetchMinSize)>(to, from, indices, count);
+	}
+
+	/* Scatter single slice chunk; there is no hardware scatter before AVX-512, so only large elements benefit from prefetching. */
+	template<typename T, typename Index>
+	void scatter_slice(T *to, const T *from, const Index *indices, size_t count)
+	{
+		scatter_slice_scalar<(sizeof(T) >= kGatherPrefetchMinSize)>(to, from, indices, count);
+	}
+
+	/* Call f(first, last) for consecutive chunks of index list, in parallel if the list is long. */
+	template<typename Executor, typename Func>
+	void for_each_index_chunk(size_t count, Executor &executor, Func &&f)
+	{
+		if (count < kParallelGatherMinIndices)
+		{
+			if (count > 0)
+				f(size_t(0), count);
+			return;
+		}
+
+		size_t numChunks = (count + kGatherChunkIndices - 1) / kGatherChunkIndices;
+		executor.bulk_execute(numChunks, [&](size_t chunk) {
+			size_t first = chunk * kGatherChunkIndices;
+			f(first, std::min(count, first + kGatherChunkIndices));
+		});
+	}
+
+	template<typename Vec, size_t... Indices>
+	using gathered_vector_t = parallel_vector_impl<type_list<type_list_element_t<Indices, typename Vec::types>...>, typename Vec::traits_type>;
+
+	template<typename Vec, typename Index, typename Executor, size_t... Indices>
+	auto gather_impl(const Vec &src, const Index *indices, size_t count, Executor &executor, std::index_sequence<Indices...>)
+	{
+		using result_type = gathered_vector_t<Vec, Indices...>;
+		if (count > std::numeric_limits<typename result_type::size_type>::max())
+			throw std::length_error("Too many indices to gather");
+		result_type result(src.traits());
+		result.reserve(static_cast<typename result_type::size_type>(count));
+
+		// rows are copy-constructed straight into reserved storage, so gathered types don't need to be default constructible
+		auto sources = std::make_tuple(src.template slice<Indices>().data()...);
+		size_t sourceSize = src.size();
+		result.append_uninitialized(static_cast<typename result_type::size_type>(count), [&](auto *... targets) {
+			auto to = std::make_tuple(targets...);
+			auto destroyRows = [&to](size_t first, size_t last, size_t numSlices) {
+				seq_call<sizeof...(Indices)>::execute([&](auto k) {
+					if (decltype(k)::value < numSlices)
+						destroy_range(std::get<decltype(k)::value>(to) + first, last - first);
+				});
+			};
+			// every chunk is all-or-nothing
+			auto gatherChunk = [&](size_t first, size_t last) {
+				size_t numDone = 0;
+				try
+				{
+					seq_call<sizeof...(Indices)>::execute([&](auto k) {
+						static constexpr const size_t K = decltype(k)::value;
+						gather_slice(std::get<K>(to) + first, std::get<K>(sources), sourceSize, indices + first, last - first);
+						++numDone;
+					});
+				}
+				catch (...)
+				{
+					destroyRows(first, last, numDone);
+					throw;
+				}
+			};
+
+			if constexpr (std::conjunction<std::is_nothrow_copy_constructible<type_list_element_t<Indices, typename Vec::types>>...>::value)
+			{
+				for_each_index_chunk(count, executor, gatherChunk);
+			}
+			else
+			{
+				// remember finished chunks, so that they can be destroyed if another one throws
+				std::vector<size_t> chunkEnds((count + kGatherChunkIndices - 1) / kGatherChunkIndices, 0);
+				try
+				{
+					for_each_index_chunk(count, executor, [&](size_t first, size_t last) {
+						gatherChunk(first, last);
+						chunkEnds[first / kGatherChunkIndices] = last;
+					});
+				}
+				catch (...)
+				{
+					for (size_t c = 0; c < chunkEnds.size(); ++c)
+						if (chunkEnds[c] != 0)
+							destroyRows(c * kGatherChunkIndices, chunkEnds[c], sizeof...(Indices));
+					throw;
+				}
+			}
+		});
+		return result;
+	}
+
+	template<typename Vec, typename Src, typename Index, typename Executor, size_t... Indices>
+	void scatter_impl(Vec &dst, const Index *indices, size_t count, const Src &src, Executor &executor, std::index_sequence<Indices...>)
+	{
+		static_assert(Src::num_slices == sizeof...(Indices), "Source should have one slice per scattered slice");
+		if (src.size() != count)
+			throw std::invalid_argument("Source size should match number of indices");
+
+		auto targets = std::make_tuple(dst.template slice<Indices>().data()...);
+		for_each_index_chunk(count, executor, [&](size_t first, size_t last) {
+			seq_call<sizeof...(Indices)>::execute([&](auto k) {
+				static constexpr const size_t K = decltype(k)::value;
+				auto *from = src.template slice<K>().data();
+				static_assert(std::is_same<std::remove_pointer_t<std::decay_t<decltype(std::get<K>(targets))>>, std::remove_const_t<std::remove_pointer_t<decltype(from)>>>::value, "Scattered slice types should match");
+				scatter_slice(std::get<K>(targets), from + first, indices + first, last - first);
+			});
+		});
+	}
+
+	template<typename Vec, size_t... Indices>
+	struct gather_indices
+	{
+		using type = std::index_sequence<Indices...>;
+	};
+
+	template<typename Vec>
+	struct gather_indices<Vec>
+	{
+		using type = std::make_index_sequence<Vec::num_slices>;
+	};
+
+	template<typename IndexRange>
+	using index_range_element_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::data(std::declval<const IndexRange &>()))>>;
+}
+
+/* Build new parallel vector from rows src[indices[0]], src[indices[1]], ... Indices select slices to gather (all if empty); result has selected slices
+ * in the same order and uses the same traits type. Index list is any contiguous range of integers (std::vector, array_view, built-in array, etc.). */
+template<size_t... Indices, typename Vec, typename IndexRange, typename Executor>
+auto gather(const Vec &src, const IndexRange &indices, Executor &executor)
+{
+	static_assert(std::is_integral<detail::index_range_element_t<IndexRange>>::value, "Indices should be integers");
+	return detail::gather_impl(src, std::data(indices), std::size(indices), executor, typename detail::gather_indices<Vec, Indices...>::type());
+}
+
+/* Same as above, using process-wide work-stealing pool for large index lists. */
+template<size_t... Indices, typename Vec, typename IndexRange>
+auto gather(const Vec &src, const IndexRange &indices)
+{
+	return gather<Indices...>(src, indices, work_stealing_pool::instance());
+}
+
+/* Assign dst[indices[i]] = src[i] for every row i of src. Indices select destination slices (all if empty); k-th slice of src is written to k-th selected slice,
+ * so the output of gather<Indices...> can be scattered back with the same Indices. Indices should be unique (chunks are written concurrently).
+ * Throws std::invalid_argument if src size doesn't match number of indices. */
+template<size_t... Indices, typename Vec, typename IndexRange, typename Src, typename Executor>
+void scatter(Vec &dst, const IndexRange &indices, const Src &src, Executor &executor)
+{
+	static_assert(std::is_integral<detail::index_range_element_t<IndexRange>>::value, "Indices should be integers");
+	detail::scatter_impl(dst, std::data(indices), std::size(indices), src, executor, typename detail::gather_indices<Vec, Indices...>::type());
+}
+
+/* Same as above, using process-wide work-stealing pool for large index lists. */
+template<size_t... Indices, typename Vec, typename IndexRange, typename Src>
+void scatter(Vec &dst, const IndexRange &indices, const Src &src)
+{
+	scatter<Indices...>(dst, indices, src, work_stealing_pool::instance());
+}
+
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "parallel_vector.h"
+#include "work_stealing_pool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+/* Sorting parallel vectors by a key slice.
+ * Sorting never swaps whole rows: first a permutation is computed from the key slice alone, then it is applied to every slice with a single gather
+ * (see parallel_vector_impl::apply_permutation), so each element of each slice is moved exactly once. */
+
+namespace utl {
+
+namespace detail {
+	/* Compute sorting permutation of the key slice. Small trivially copyable keys are sorted together with indices, so that comparisons
+	 * touch contiguous memory instead of doing random lookups into the key slice; other keys are accessed indirectly through index. */
+	template<bool Stable, typename SizeType, typename Key, typename Compare>
+	std::vector<SizeType> sort_permutation(const Key *keys, size_t size, Compare &cmp)
+	{
+		std::vector<SizeType> order(size);
+		if constexpr (std::is_trivially_copyable<Key>::value && sizeof(Key) <= 16)
+		{
+			struct item
+			{
+				Key key;
+				SizeType index;
+			};
+			std::vector<item> items(size);
+			for (size_t i = 0; i < size; ++i)
+				items[i] = { keys[i], static_cast<SizeType>(i) };
+
+			auto itemCmp = [&cmp](const item &a, const item &b) { return cmp(a.key, b.key); };
+			if (Stable)
+				std::stable_sort(items.begin(), items.end(), itemCmp);
+			else
+				std::sort(items.begin(), items.end(), itemCmp);
+
+			for (size_t i = 0; i < size; ++i)
+				order[i] = items[i].index;
+		}
+		else
+		{
+			std::iota(order.begin(), order.end(), SizeType(0));
+			auto indexCmp = [keys, &cmp](SizeType a, SizeType b) { return cmp(keys[a], keys[b]); };
+			if (Stable)
+				std::stable_sort(order.begin(), order.end(), indexCmp);
+			else
+				std::sort(order.begin(), order.end(), indexCmp);
+		}
+		return order;
+	}
+
+	/* Map arithmetic key to unsigned integer with the same ordering (two's complement sign flip for signed ints, sign-magnitude flip for floats). */
+	template<typename Key>
+	auto radix_key(Key key)
+	{
+		static_assert(std::is_arithmetic<Key>::value && sizeof(Key) <= 8, "Radix sort supports only arithmetic keys up to 64 bits");
+		using bits_type = std::conditional_t<sizeof(Key) <= 1, uint8_t, std::conditional_t<sizeof(Key) <= 2, uint16_t, std::conditional_t<sizeof(Key) <= 4, uint32_t, uint64_t>>>;
+		static const constexpr bits_type kSignBit = bits_type(1) << (sizeof(bits_type) * 8 - 1);
+
+		bits_type bits;
+		std::memcpy(&bits, &key, sizeof(Key));
+		if constexpr (std::is_floating_point<Key>::value)
+			return (bits & kSignBit) ? bits_type(~bits) : bits_type(bits | kSignBit);
+		else if constexpr (std::is_signed<Key>::value)
+			return bits_type(bits ^ kSignBit);
+		else
+			return bits;
+	}
+
+	/* LSD radix sort of (key, index) pairs by 8-bit digits; digits identical for all keys are skipped.
+	 * Each pass is split into chunks: histograms are built per chunk in parallel, then each chunk scatters its elements to precomputed offsets in parallel.
+	 * Chunks are processed in order of their offsets, so the sort is stable. */
+	template<typename SizeType, typename Key, typename Executor>
+	std::vector<SizeType> radix_sort_permutation(const Key *keys, size_t size, Executor &executor)
+	{
+		using radix_type = decltype(radix_key(std::declval<Key>()));
+		struct item
+		{
+			radix_type key;
+			SizeType index;
+		};
+
+		static const constexpr size_t kNumBuckets = 256;
+		static const constexpr size_t kNumPasses = sizeof(radix_type);
+		static const constexpr size_t kMinChunkSize = 1 << 16;
+		static const constexpr size_t kMaxChunks = 64;
+		size_t numChunks = std::max<size_t>(1, std::min(kMaxChunks, size / kMinChunkSize));
+		size_t chunkSize = (size + numChunks - 1) / std::max<size_t>(numChunks, 1);
+
+		std::vector<item> items(size), scratch(size);
+		executor.bulk_execute(numChunks, [&](size_t chunk) {
+			size_t first = chunk * chunkSize, last = std::min(size, first + chunkSize);
+			for (size_t i = first; i < last; ++i)
+				items[i] = { radix_key(keys[i]), static_cast<SizeType>(i) };
+		});
+
+		std::vector<size_t> histograms(numChunks * kNumBuckets);
+		for (size_t pass = 0; pass < kNumPasses; ++pass)
+		{
+			const size_t shift = pass * 8;
+
+			std::fill(histograms.begin(), histograms.end(), 0);
+			executor.bulk_execute(numChunks, [&](size_t chunk) {
+				size_t *hist = histograms.data() + chunk * kNumBuckets;
+				size_t first = chunk * chunkSize, last = std::min(size, first + chunkSize);
+				for (size_t i = first; i < last; ++i)
+					++hist[(items[i].key >> shift) & 0xFF];
+			});
+
+			// convert counts to starting offsets, ordered by (digit, chunk); skip the pass if every key has the same digit
+			size_t offset = 0;
+			bool trivialPass = false;
+			for (size_t digit = 0; digit < kNumBuckets; ++digit)
+			{
+				for (size_t chunk = 0; chunk < numChunks; ++chunk)
+				{
+					size_t count = histograms[chunk * kNumBuckets + digit];
+					trivialPass |= count == size;
+					histograms[chunk * kNumBuckets + digit] = offset;
+					offset += count;
+				}
+			}
+			if (trivialPass)
+				continue;
+
+			executor.bulk_execute(numChunks, [&](size_t chunk) {
+				size_t *offsets = histograms.data() + chunk * kNumBuckets;
+				size_t first = chunk * chunkSize, last = std::min(size, first + chunkSize);
+				for (size_t i = first; i < last; ++i)
+					scratch[offsets[(items[i].key >> shift) & 0xFF]++] = items[i];
+			});
+			items.swap(scratch);
+		}
+
+		std::vector<SizeType> order(size);
+		executor.bulk_execute(numChunks, [&](size_t chunk) {
+			size_t first = chunk * chunkSize, last = std::min(size, first + chunkSize);
+			for (size_t i = first; i < last; ++i)
+				order[i] = items[i].index;
+		});
+		return order;
+	}
+}
+
+/* Sort rows by the key slice using given comparator. */
+template<size_t KeyIndex, typename Vec, typename Compare = std::less<>>
+void sort_by(Vec &vec, Compare cmp = Compare())
+{
+	using size_type = typename Vec::size_type;
+	auto keys = vec.template slice<KeyIndex>();
+	auto order = detail::sort_permutation<false, size_type>(keys.data(), keys.size(), cmp);
+	vec.apply_permutation(order.data());
+}
+
+template<typename Key, typename Vec, typename Compare = std::less<>>
+void sort_by(Vec &vec, Compare cmp = Compare())
+{
+	sort_by<detail::find_type_index<Key, typename Vec::types>::value>(vec, cmp);
+}
+
+/* Sort rows by the key slice, preserving relative order of rows with equivalent keys. */
+template<size_t KeyIndex, typename Vec, typename Compare = std::less<>>
+void stable_sort_by(Vec &vec, Compare cmp = Compare())
+{
+	using size_type = typename Vec::size_type;
+	auto keys = vec.template slice<KeyIndex>();
+	auto order = detail::sort_permutation<true, size_type>(keys.data(), keys.size(), cmp);
+	vec.apply_permutation(order.data());
+}
+
+template<typename Key, typename Vec, typename Compare = std::less<>>
+void stable_sort_by(Vec &vec, Compare cmp = Compare())
+{
+	stable_sort_by<detail::find_type_index<Key, typename Vec::types>::value>(vec, cmp);
+}
+
+/* Stable ascending sort by arithmetic key slice (integers or floating point up to 64 bits) using LSD radix sort.
+ * Large vectors are processed in parallel chunks on given executor (see work_stealing_pool.h). Negative zero sorts before positive zero, NaNs go to the ends. */
+template<size_t KeyIndex, typename Vec, typename Executor>
+void radix_sort_by(Vec &vec, Executor &executor)
+{
+	using size_type = typename Vec::size_type;
+	auto keys = vec.template slice<KeyIndex>();
+	auto order = detail::radix_sort_permutation<size_type>(keys.data(), keys.size(), executor);
+	vec.apply_permutation(order.data());
+}
+
+template<size_t KeyIndex, typename Vec>
+void radix_sort_by(Vec &vec)
+{
+	radix_sort_by<KeyIndex>(vec, work_stealing_pool::instance());
+}
+
+template<typename Key, typename Vec, typename Executor>
+void radix_sort_by(Vec &vec, Executor &executor)
+{
+	radix_sort_by<detail::find_type_index<Key, typename Vec::types>::value>(vec, executor);
+}
+
+template<typename Key, typename Vec>
+void radix_sort_by(Vec &vec)
+{
+	radix_sort_by<detail::find_type_index<Key, typename Vec::types>::value>(vec);
+}
+
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+#include <vector>
+
+namespace utl {
+
+namespace detail {
+	/* Segmented parallel vector: rows are stored in fixed-size chunks, each chunk being a regular parallel vector (SoA block) with fixed capacity.
+	 * Appending never moves existing rows (only the small table of chunk headers can grow), so element addresses are stable and there are no
+	 * full-copy reallocation stalls or transient 2x memory peaks. Inner loops should iterate over chunks and use per-chunk slices, which are contiguous.
+	 * Chunks ignore auto-shrink policy of traits, so pop_back doesn't move rows either.
+	 * Note: ChunkRows should not be a power of two, for the same aliasing reasons as parallel vector capacity. */
+	template<typename TypeList, typename Traits, size_t ChunkRows>
+	class segmented_parallel_vector_impl
+	{
+	public:
+		using chunk_type = parallel_vector_impl<TypeList, without_auto_shrink_t<Traits>>;
+		using chunk_size_type = typename chunk_type::size_type;
+		using size_type = size_t;
+		using types = TypeList;
+
+		static const constexpr size_t chunk_rows = ChunkRows;
+		static const constexpr size_t num_slices = TypeList::size;
+
+		/* Create empty vector; traits instance (if passed) is copied into every chunk. */
+		segmented_parallel_vector_impl() = default;
+		explicit segmented_parallel_vector_impl(const Traits &traits) : mTraits(traits) {}
+
+		/* Number of rows, chunks and reserved rows. */
+		bool empty() const { return mSize == 0; }
+		size_type size() const { return mSize; }
+		size_type capacity() const { return mChunks.size() * ChunkRows; }
+		size_t num_chunks() const { return (mSize + ChunkRows - 1) / ChunkRows; }
+
+		/* Access single chunk; chunk i contains rows [i * chunk_rows, min(size, (i + 1) * chunk_rows)). */
+		chunk_type &chunk(size_t index) { return mChunks[index]; }
+		const chunk_type &chunk(size_t index) const { return mChunks[index]; }
+
+		/* Access single element of a slice by row index. */
+		template<size_t Index> auto &get(size_type row)
+		{
+			return mChunks[row / ChunkRows].template slice<Index>()[static_cast<chunk_size_type>(row % ChunkRows)];
+		}
+		template<size_t Index> const auto &get(size_type row) const
+		{
+			return mChunks[row / ChunkRows].template slice<Index>()[static_cast<chunk_size_type>(row % ChunkRows)];
+		}
+		template<typename Type> auto &get(size_type row)
+		{
+			return get<find_type_index<Type, TypeList>::value>(row);
+		}
+		template<typename Type> const auto &get(size_type row) const
+		{
+			return get<find_type_index<Type, TypeList>::value>(row);
+		}
+
+		/* Call f(chunkSlice0, chunkSlice1, ...) for each non-empty chunk, passing views of selected slices (all if Indices is empty). */
+		template<size_t... Indices, typename Func>
+		void for_each_chunk(Func &&f)
+		{
+			for_each_chunk_impl(*this, f, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+		template<size_t... Indices, typename Func>
+		void for_each_chunk(Func &&f) const
+		{
+			for_each_chunk_impl(*this, f, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+
+		/* Make sure there are enough chunks allocated for given number of rows. Never moves existing rows. */
+		void reserve(size_type capacity)
+		{
+			size_t numChunks = (capacity + ChunkRows - 1) / ChunkRows;
+			if (numChunks <= mChunks.size())
+				return;
+
+			mChunks.reserve(numChunks);
+			while (mChunks.size() < numChunks)
+				mChunks.emplace_back(mTraits, static_cast<chunk_size_type>(ChunkRows));
+		}
+
+		/* Append new row, same semantics as parallel_vector_impl::push_back. */
+		template<typename... Args>
+		void push_back(Args &&... args)
+		{
+			size_t chunkIndex = mSize / ChunkRows;
+			if (chunkIndex == mChunks.size())
+				mChunks.emplace_back(mTraits, static_cast<chunk_size_type>(ChunkRows));
+
+			mChunks[chunkIndex].push_back(std::forward<Args>(args)...);
+			++mSize;
+		}
+
+		/* Erase last row. */
+		void pop_back()
+		{
+			--mSize;
+			mChunks[mSize / ChunkRows].pop_back();
+		}
+
+		/* Destroy all rows; chunks are kept allocated. */
+		void clear()
+		{
+			for (auto &c : mChunks)
+				c.clear();
+			mSize = 0;
+		}
+
+		/* Release chunks that contain no rows. */
+		void shrink_to_fit()
+		{
+			mChunks.erase(mChunks.begin() + num_chunks(), mChunks.end());
+			mChunks.shrink_to_fit();
+		}
+
+	private:
+		template<typename Self, typename Func, size_t... Indices>
+		static void for_each_chunk_impl(Self &self, Func &f, std::index_sequence<Indices...>)
+		{
+			size_t numChunks = self.num_chunks();
+			for (size_t i = 0; i < numChunks; ++i)
+				f(self.mChunks[i].template slice<Indices>()...);
+		}
+
+	private:
+		Traits					mTraits;
+		std::vector<chunk_type>	mChunks;
+		size_type				mSize = 0;
+	};
+}
+
+/* Segmented parallel vector with default traits and chunk size. */
+template<typename... Types>
+using segmented_parallel_vector = detail::segmented_parallel_vector_impl<detail::type_list<Types...>, default_parallel_vector_traits, 16000>;
+
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+#include <tuple>
+#include <utility>
+
+namespace utl {
+
+namespace detail {
+	/* Single-writer / many-reader parallel vector with RCU-style publication.
+	 * Every slice is stored in its own column (single-slice parallel vector) owned through shared_ptr. The writer thread mutates the vector
+	 * and calls publish() to make current state visible; any thread can take a snapshot of the last published state, which is an immutable,
+	 * refcounted set of columns with slice<I>() views, cheap to take and hold. Columns are copied on write per slice: the first modification
+	 * of a published row clones only the modified column, unchanged columns are shared between versions, and a block is freed when
+	 * the last snapshot (or the writer) referencing it goes away. Appending into spare capacity doesn't copy, since published snapshots
+	 * never look past their own size; growing a shared column allocates a new one instead of reallocating in place.
+	 * All member functions except snapshot() must be called from the writer thread. */
+	template<typename TypeList, typename Traits>
+	class snapshot_parallel_vector_impl
+	{
+	public:
+		using size_type = typename Traits::size_type;
+		using types = TypeList;
+
+		static const constexpr size_t num_slices = TypeList::size;
+
+		template<size_t Index>
+		using column_type = parallel_vector_impl<type_list<type_list_element_t<Index, TypeList>>, Traits>;
+
+	private:
+		/* Immutable published state: data pointers and sizes are captured at publication, so readers never touch column objects being modified by writer. */
+		struct published_state
+		{
+			uint64_t										number;
+			size_type										size;
+			std::array<const void *, TypeList::size>		data;
+			std::array<std::shared_ptr<const void>, TypeList::size>	columns;
+		};
+
+	public:
+		/* Consistent read-only view of a published version; keeps its columns alive. */
+		class snapshot_type
+		{
+		public:
+			snapshot_type() = default;
+
+			/* Publication number (0 for snapshot of nothing). */
+			uint64_t version() const { return mState ? mState->number : 0; }
+			bool empty() const { return size() == 0; }
+			size_type size() const { return mState ? mState->size : 0; }
+
+			template<size_t Index> auto slice() const
+			{
+				using type = type_list_element_t<Index, TypeList>;
+				return make_array_view(mState ? static_cast<const type *>(mState->data[Index]) : nullptr, size());
+			}
+			template<typename Type> auto slice() const { return slice<find_type_index<Type, TypeList>::value>(); }
+
+			template<size_t Index> const auto &get(size_type row) const { return slice<Index>()[row]; }
+			template<typename Type> const auto &get(size_type row) const { return get<find_type_index<Type, TypeList>::value>(row); }
+
+		private:
+			friend class snapshot_parallel_vector_impl;
+			explicit snapshot_type(std::shared_ptr<const published_state> v) : mState(std::move(v)) {}
+
+			std::shared_ptr<const published_state> mState;
+		};
+
+		explicit snapshot_parallel_vector_impl(const Traits &traits = Traits())
+			: mColumns(make_columns(traits, std::make_index_sequence<TypeList::size>()))
+		{
+		}
+
+		snapshot_parallel_vector_impl(const snapshot_parallel_vector_impl &) = delete;
+		snapshot_parallel_vector_impl &operator=(const snapshot_parallel_vector_impl &) = delete;
+
+		/* Make current state visible to snapshot(); returns publication number. */
+		uint64_t publish()
+		{
+			auto v = std::make_shared<published_state>();
+			v->number = ++mVersion;
+			v->size = mSize;
+			seq_call<TypeList::size>::execute([&](auto sliceIndex) {
+				static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+				auto &c = std::get<kSliceIndex>(mColumns);
+				v->data[kSliceIndex] = c.data->template slice<0>().data();
+				v->columns[kSliceIndex] = c.data;
+				c.publishedRows = mSize;
+			});
+			std::atomic_store_explicit(&mPublished, std::shared_ptr<const published_state>(std::move(v)), std::memory_order_release);
+			return mVersion;
+		}
+
+		/* Last published version; can be called from any thread. */
+		snapshot_type snapshot() const
+		{
+			return snapshot_type(std::atomic_load_explicit(&mPublished, std::memory_order_acquire));
+		}
+
+		/* Writer-side state. */
+		bool empty() const { return mSize == 0; }
+		size_type size() const { return mSize; }
+		template<size_t Index> auto slice() const { return std::as_const(*std::get<Index>(mColumns).data).template slice<0>(); }
+		template<typename Type> auto slice() const { return slice<find_type_index<Type, TypeList>::value>(); }
+		template<size_t Index> const auto &get(size_type row) const { return slice<Index>()[row]; }
+		template<typename Type> const auto &get(size_type row) const { return get<find_type_index<Type, TypeList>::value>(row); }
+
+		/* Writable access to single element, rows [first, last) or whole slice; column is cloned first if modified rows are visible to a snapshot. */
+		template<size_t Index> auto &write(size_type row)
+		{
+			return writable<Index>(row).template slice<0>()[row];
+		}
+		template<size_t Index> auto write_range(size_type first, size_type last)
+		{
+			auto slice = writable<Index>(first).template slice<0>();
+			return make_array_view(slice.data() + first, last - first);
+		}
+		template<size_t Index> auto write_slice()
+		{
+			return writable<Index>(0).template slice<0>();
+		}
+		template<typename Type> auto &write(size_type row) { return write<find_type_index<Type, TypeList>::value>(row); }
+		template<typename Type> auto write_range(size_type first, size_type last) { return write_range<find_type_index<Type, TypeList>::value>(first, last); }
+		template<typename Type> auto write_slice() { return write_slice<find_type_index<Type, TypeList>::value>(); }
+
+		/* Make sure every column can hold given number of rows; shared columns are moved to new blocks. */
+		void reserve(size_type capacity)
+		{
+			seq_call<TypeList::size>::execute([&](auto sliceIndex) { growable<decltype(sliceIndex)::value>(capacity).reserve(capacity); });
+		}
+
+		/* Append new row, same semantics as parallel_vector_impl::push_back. If construction of some element throws, row is not added. */
+		template<typename... Args>
+		void push_back(Args &&... args)
+		{
+			static_assert(sizeof...(Args) == TypeList::size, "Every slice needs an argument");
+			size_t numPushed = 0;
+			try
+			{
+				seq_call<TypeList::size>::execute([&, argTuple = std::forward_as_tuple(std::forward<Args>(args)...)](auto sliceIndex) mutable {
+					static constexpr const size_t kSliceIndex = decltype(sliceIndex)::value;
+					growable<kSliceIndex>(mSize + 1).push_back(std::get<kSliceIndex>(std::move(argTuple)));
+					++numPushed;
+				});
+			}
+			catch (...)
+			{
+				seq_call<TypeList::size>::execute([&](auto sliceIndex) {
+					if (decltype(sliceIndex)::value < numPushed)
+						std::get<decltype(sliceIndex)::value>(mColumns).data->pop_back();
+				});
+				throw;
+			}
+			++mSize;
+		}
+
+		/* Removal; shared columns are cloned first (all of them before anything is erased), since removal may destroy published rows or shrink the block. */
+		void erase(size_type begin, size_type end)
+		{
+			seq_call<TypeList::size>::execute([&](auto sliceIndex) { make_private<decltype(sliceIndex)::value>(); });
+			seq_call<TypeList::size>::execute([&](auto sliceIndex) { std::get<decltype(sliceIndex)::value>(mColumns).data->erase(begin, end); });
+			mSize -= end - begin;
+		}
+		void pop_back() { erase(mSize - 1, mSize); }
+
+		/* Destroy all rows; shared columns are simply dropped (snapshots keep them alive). */
+		void clear()
+		{
+			seq_call<TypeList::size>::execute([&](auto sliceIndex) {
+				auto &c = std::get<decltype(sliceIndex)::value>(mColumns);
+				if (shared<decltype(sliceIndex)::value>())
+					c = { std::make_shared<column_type<decltype(sliceIndex)::value>>(c.data->traits()), 0 };
+				else
+					c.data->clear();
+			});
+			mSize = 0;
+		}
+
+	private:
+		template<size_t Index>
+		struct column
+		{
+			std::shared_ptr<column_type<Index>>	data;
+			size_type							publishedRows;	// rows visible to the latest snapshot referencing data
+		};
+
+		template<size_t... Indices>
+		static auto make_columns(const Traits &traits, std::index_sequence<Indices...>)
+		{
+			return std::make_tuple(column<Indices>{ std::make_shared<column_type<Indices>>(traits), 0 }...);
+		}
+
+		using columns_type = decltype(make_columns(std::declval<const Traits &>(), std::make_index_sequence<TypeList::size>()));
+
+		/* Column is shared if any snapshot (including the published one) references it. Count can only drop concurrently,
+		 * since readers obtain references solely through versions, so a false positive merely causes an extra copy.
+		 * Every in-place write must be preceded by this check returning false: use_count() is a relaxed load, so the acquire fence is what
+		 * orders the last reader's accesses (released by its reference count decrement) before the writer's modifications. */
+		template<size_t Index>
+		bool shared() const
+		{
+			if (std::get<Index>(mColumns).data.use_count() > 1)
+				return true;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return false;
+		}
+
+		/* Replace column with its private copy having at least given capacity. */
+		template<size_t Index>
+		void clone(size_type capacity)
+		{
+			auto &c = std::get<Index>(mColumns);
+			auto copy = std::make_shared<column_type<Index>>(c.data->traits(), std::max(capacity, c.data->size()));
+			copy->insert_copy(0, std::as_const(*c.data), 0, c.data->size());
+			c = { std::move(copy), 0 };
+		}
+
+		/* Column whose rows starting from firstRow can be modified in place. */
+		template<size_t Index>
+		column_type<Index> &writable(size_type firstRow)
+		{
+			auto &c = std::get<Index>(mColumns);
+			if (firstRow < c.publishedRows && shared<Index>())
+				clone<Index>(c.data->capacity());
+			return *c.data;
+		}
+
+		/* Column which can hold given number of rows without reallocating a block visible to snapshots. */
+		template<size_t Index>
+		column_type<Index> &growable(size_type required)
+		{
+			auto &c = std::get<Index>(mColumns);
+			if (required > c.data->capacity() && shared<Index>())
+				clone<Index>(std::max<size_type>(required, c.data->capacity() * 2 + 1));
+			return *c.data;
+		}
+
+		template<size_t Index>
+		void make_private()
+		{
+			if (shared<Index>())
+				clone<Index>(std::get<Index>(mColumns).data->capacity());
+		}
+
+	private:
+		columns_type					mColumns;
+		size_type						mSize = 0;
+		uint64_t						mVersion = 0;
+		std::shared_ptr<const published_state>	mPublished;
+	};
+}
+
+/* Snapshot-publishing parallel vector with default traits. */
+template<typename... Types>
+using snapshot_parallel_vector = detail::snapshot_parallel_vector_impl<detail::type_list<Types...>, default_parallel_vector_traits>;
+
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+/* Instrumented traits: every vector using stats traits reports allocations, growth and element moves into counters shared by all vectors
+ * with the same signature (type list by default), so that containers causing most reallocation traffic can be found in a running program.
+ * Usage: utl::stats_parallel_vector<int, float> vec; ...; utl::dump_parallel_vector_stats(stdout);
+ * Counters are atomic (relaxed), so vectors can be used from any thread; the overhead is a few atomic increments per reallocation/insert/erase. */
+
+namespace utl {
+
+/* Aggregated counters for a single signature. */
+struct parallel_vector_stats
+{
+	std::atomic<uint64_t> allocations{ 0 };
+	std::atomic<uint64_t> deallocations{ 0 };
+	std::atomic<uint64_t> bytesAllocated{ 0 };
+	std::atomic<uint64_t> bytesDeallocated{ 0 };
+	std::atomic<uint64_t> grows{ 0 };
+	std::atomic<uint64_t> maxCapacity{ 0 };
+	std::atomic<uint64_t> shrinks{ 0 };
+	std::atomic<uint64_t> relocations{ 0 };
+	std::atomic<uint64_t> bytesRelocated{ 0 };
+	std::atomic<uint64_t> elementsRelocated{ 0 };
+	std::atomic<uint64_t> eraseShifts{ 0 };
+	std::atomic<uint64_t> bytesShifted{ 0 };
+	std::atomic<uint64_t> elementsShifted{ 0 };
+
+	/* Bytes currently allocated by live vectors. */
+	uint64_t live_bytes() const { return bytesAllocated.load(std::memory_order_relaxed) - bytesDeallocated.load(std::memory_order_relaxed); }
+};
+
+/* Global list of all signatures that reported anything. */
+class parallel_vector_stats_registry
+{
+public:
+	struct entry
+	{
+		std::string				name;
+		parallel_vector_stats	*stats;
+	};
+
+	static parallel_vector_stats_registry &instance()
+	{
+		static parallel_vector_stats_registry registry;
+		return registry;
+	}
+
+	void add(std::string name, parallel_vector_stats *stats)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mEntries.push_back({ std::move(name), stats });
+	}
+
+	/* Copy of current entry list (counters are still live). */
+	std::vector<entry> entries() const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mEntries;
+	}
+
+private:
+	mutable std::mutex	mMutex;
+	std::vector<entry>	mEntries;
+};
+
+namespace detail {
+	/* Human-readable type name (demangled where supported). */
+	inline std::string readable_type_name(const std::type_info &type)
+	{
+#if defined(__GNUG__)
+		int status = 0;
+		char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+		if (status == 0 && demangled)
+		{
+			std::string result(demangled);
+			std::free(demangled);
+			return result;
+		}
+#endif
+		return type.name();
+	}
+}
+
+/* Traits forwarding allocation to Base and aggregating instrumentation events per Signature (any tag type; type_list of element types for aliases below). */
+template<typename Signature, typename Base = default_parallel_vector_traits>
+struct stats_parallel_vector_traits : Base
+{
+	using Base::Base;
+	stats_parallel_vector_traits() = default;
+	stats_parallel_vector_traits(const Base &base) : Base(base) {}
+
+	/* Counters shared by all vectors with this signature; registered on first use. */
+	static parallel_vector_stats &stats()
+	{
+		static parallel_vector_stats *instance = [] {
+			static parallel_vector_stats counters;
+			parallel_vector_stats_registry::instance().add(detail::readable_type_name(typeid(Signature)), &counters);
+			return &counters;
+		}();
+		return *instance;
+	}
+
+	void on_allocate(size_t bytes)
+	{
+		auto &s = stats();
+		s.allocations.fetch_add(1, std::memory_order_relaxed);
+		s.bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	void on_deallocate(size_t bytes)
+	{
+		auto &s = stats();
+		s.deallocations.fetch_add(1, std::memory_order_relaxed);
+		s.bytesDeallocated.fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	void on_grow(size_t, size_t newCapacity)
+	{
+		auto &s = stats();
+		s.grows.fetch_add(1, std::memory_order_relaxed);
+		uint64_t prev = s.maxCapacity.load(std::memory_order_relaxed);
+		while (prev < newCapacity && !s.maxCapacity.compare_exchange_weak(prev, newCapacity, std::memory_order_relaxed)) {}
+	}
+
+	void on_shrink(size_t, size_t)
+	{
+		stats().shrinks.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void on_relocate(size_t bytes, size_t elements)
+	{
+		auto &s = stats();
+		s.relocations.fetch_add(1, std::memory_order_relaxed);
+		s.bytesRelocated.fetch_add(bytes, std::memory_order_relaxed);
+		s.elementsRelocated.fetch_add(elements, std::memory_order_relaxed);
+	}
+
+	void on_erase_shift(size_t bytes, size_t elements)
+	{
+		auto &s = stats();
+		s.eraseShifts.fetch_add(1, std::memory_order_relaxed);
+		s.bytesShifted.fetch_add(bytes, std::memory_order_relaxed);
+		s.elementsShifted.fetch_add(elements, std::memory_order_relaxed);
+	}
+};
+
+/* Print counters of all registered signatures, sorted by bytes moved (relocated + shifted), largest first. */
+inline void dump_parallel_vector_stats(std::FILE *out)
+{
+	auto entries = parallel_vector_stats_registry::instance().entries();
+	auto moved = [](const parallel_vector_stats &s) { return s.bytesRelocated.load(std::memory_order_relaxed) + s.bytesShifted.load(std::memory_order_relaxed); };
+	std::sort(entries.begin(), entries.end(), [&](const auto &lhs, const auto &rhs) { return moved(*lhs.stats) > moved(*rhs.stats); });
+
+	std::fprintf(out, "%10s %10s %12s %8s %10s %8s %10s %14s %10s %14s  %s\n", "allocs", "frees", "live bytes", "grows", "max cap", "shrinks", "relocs", "bytes reloc", "shifts", "bytes shifted", "signature");
+	for (auto &e : entries)
+	{
+		auto &s = *e.stats;
+		std::fprintf(out, "%10llu %10llu %12llu %8llu %10llu %8llu %10llu %14llu %10llu %14llu  %s\n",
+			(unsigned long long)s.allocations.load(std::memory_order_relaxed), (unsigned long long)s.deallocations.load(std::memory_order_relaxed),
+			(unsigned long long)s.live_bytes(), (unsigned long long)s.grows.load(std::memory_order_relaxed), (unsigned long long)s.maxCapacity.load(std::memory_order_relaxed),
+			(unsigned long long)s.shrinks.load(std::memory_order_relaxed), (unsigned long long)s.relocations.load(std::memory_order_relaxed),
+			(unsigned long long)s.bytesRelocated.load(std::memory_order_relaxed), (unsigned long long)s.eraseShifts.load(std::memory_order_relaxed),
+			(unsigned long long)s.bytesShifted.load(std::memory_order_relaxed), e.name.c_str());
+	}
+}
+
+/* Parallel vector with default allocation, reporting into stats of its type list. */
+template<typename... Types>
+using stats_parallel_vector = detail::parallel_vector_impl<detail::type_list<Types...>, stats_parallel_vector_traits<detail::type_list<Types...>>>;
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace utl {
+
+/* Random-access iterator over elements separated by constant stride in bytes. */
+template<typename T>
+class strided_iterator
+{
+	using byte_type = std::conditional_t<std::is_const<T>::value, const char, char>;
+
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = std::remove_const_t<T>;
+	using reference = T &;
+	using pointer = T *;
+	using difference_type = ptrdiff_t;
+
+	strided_iterator() = default;
+	strided_iterator(T *ptr, difference_type stride) : mPtr(ptr), mStride(stride) {}
+
+	reference operator*() const { return *mPtr; }
+	pointer operator->() const { return mPtr; }
+	reference operator[](difference_type n) const { return *advance(mPtr, n); }
+
+	strided_iterator &operator++() { mPtr = advance(mPtr, 1); return *this; }
+	strided_iterator &operator--() { mPtr = advance(mPtr, -1); return *this; }
+	strided_iterator operator++(int) { auto tmp = *this; ++*this; return tmp; }
+	strided_iterator operator--(int) { auto tmp = *this; --*this; return tmp; }
+
+	strided_iterator &operator+=(difference_type n) { mPtr = advance(mPtr, n); return *this; }
+	strided_iterator &operator-=(difference_type n) { mPtr = advance(mPtr, -n); return *this; }
+	friend strided_iterator operator+(strided_iterator it, difference_type n) { return it += n; }
+	friend strided_iterator operator+(difference_type n, strided_iterator it) { return it += n; }
+	friend strided_iterator operator-(strided_iterator it, difference_type n) { return it -= n; }
+	friend difference_type operator-(const strided_iterator &lhs, const strided_iterator &rhs)
+	{
+		return lhs.mStride != 0 ? (reinterpret_cast<byte_type *>(lhs.mPtr) - reinterpret_cast<byte_type *>(rhs.mPtr)) / lhs.mStride : 0;
+	}
+
+	friend bool operator==(const strided_iterator &lhs, const strided_iterator &rhs) { return lhs.mPtr == rhs.mPtr; }
+	friend bool operator!=(const strided_iterator &lhs, const strided_iterator &rhs) { return lhs.mPtr != rhs.mPtr; }
+	friend bool operator<(const strided_iterator &lhs, const strided_iterator &rhs) { return rhs - lhs > 0; }
+	friend bool operator>(const strided_iterator &lhs, const strided_iterator &rhs) { return lhs - rhs > 0; }
+	friend bool operator<=(const strided_iterator &lhs, const strided_iterator &rhs) { return !(lhs > rhs); }
+	friend bool operator>=(const strided_iterator &lhs, const strided_iterator &rhs) { return !(lhs < rhs); }
+
+private:
+	T *advance(T *ptr, difference_type n) const
+	{
+		return reinterpret_cast<T *>(reinterpret_cast<byte_type *>(ptr) + n * mStride);
+	}
+
+private:
+	T				*mPtr = nullptr;
+	difference_type	mStride = 0;
+};
+
+/* Strided array view is a non-owning range of elements separated by constant stride in bytes, e.g. single member of an array of structures.
+ * Interface mirrors array_view, except that there is no data() (elements are not contiguous); use stride() for manual pointer arithmetic. */
+template<typename T>
+class strided_array_view
+{
+public:
+	// Exposed typedefs
+	typedef std::remove_const_t<T> value_type;
+	typedef T &reference;
+	typedef const T &const_reference;
+	typedef T *pointer;
+	typedef const T *const_pointer;
+	typedef strided_iterator<T> iterator;
+	typedef strided_iterator<const T> const_iterator;
+	typedef ptrdiff_t difference_type;
+	typedef size_t size_type;
+
+	/* Default constructor creates empty range. */
+	strided_array_view() = default;
+
+	/* Constructor: range defined by first element, stride between elements in bytes and number of elements. */
+	strided_array_view(T *first, difference_type stride, size_type size) : mFirst(first), mStride(stride), mSize(size) {}
+
+	// Element access
+	reference at(size_type pos) { throw_out_of_range_if(pos >= mSize); return (*this)[pos]; }
+	const_reference at(size_type pos) const { throw_out_of_range_if(pos >= mSize); return (*this)[pos]; }
+
+	reference operator[](size_type pos) { return begin()[static_cast<difference_type>(pos)]; }
+	const_reference operator[](size_type pos) const { return begin()[static_cast<difference_type>(pos)]; }
+
+	reference front() { return *mFirst; }
+	const_reference front() const { return *mFirst; }
+
+	reference back() { return (*this)[mSize - 1]; }
+	const_reference back() const { return (*this)[mSize - 1]; }
+
+	// Iterators
+	iterator begin() noexcept { return iterator(mFirst, mStride); }
+	const_iterator begin() const noexcept { return const_iterator(mFirst, mStride); }
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	iterator end() noexcept { return begin() + static_cast<difference_type>(mSize); }
+	const_iterator end() const noexcept { return begin() + static_cast<difference_type>(mSize); }
+	const_iterator cend() const noexcept { return end(); }
+
+	// Size & layout
+	bool empty() const noexcept { return mSize == 0; }
+	size_type size() const noexcept { return mSize; }
+	difference_type stride() const noexcept { return mStride; }
+
+private:
+	/* Throw std::out_of_range if condition is true. */
+	static void throw_out_of_range_if(bool condition)
+	{
+		if (condition)
+			throw std::out_of_range("Index out of range");
+	}
+
+private:
+	T				*mFirst = nullptr;
+	difference_type	mStride = 0;
+	size_type		mSize = 0;
+};
+
+}
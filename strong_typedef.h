@@ -1,5 +1,8 @@
 #pragma once
 
+#include <type_traits>
+#include <utility>
+
 /* "Strong typedef" is similar to standard typedef, except that it synthesizes proper new type, distinct from any other.
  * The main usecase is creating "named tuples" and being able to access distinct tuple elements of "same type" by unique type name.
  *
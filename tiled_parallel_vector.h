@@ -0,0 +1,298 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+namespace utl {
+
+namespace detail {
+	/* Tiled (AoSoA) parallel vector: rows are grouped into tiles of TileWidth rows, each tile stores TileWidth elements of first type, then TileWidth
+	 * elements of second type and so on. Kernels touching several fields stream through a single memory region (one tile after another) instead
+	 * of one region per field, which is friendlier to TLB & prefetchers, and there is no aliasing between fields regardless of capacity.
+	 * Tile-wise access (tile<I>(t), for_each_tile) gives contiguous arrays of TileWidth elements suitable for SIMD; per-element access needs a division.
+	 * Since tile layout doesn't depend on capacity, growth relocates the whole used part of the block with a single memcpy if all types are trivially relocatable.
+	 * Note: TileWidth should be a multiple of every type's alignment; tile-wise arrays are aligned to alignment of the allocation or TileWidth * sizeof(T),
+	 * whichever is smaller. */
+	template<typename TypeList, typename Traits, size_t TileWidth>
+	class tiled_parallel_vector_impl : private Traits
+	{
+	public:
+		using typename Traits::size_type;
+		using types = TypeList;
+		using traits_type = Traits;
+
+		static const constexpr size_t num_slices = TypeList::size;
+		static const constexpr size_t tile_width = TileWidth;
+		static const constexpr size_t tile_bytes = TileWidth * type_list_layout<TypeList>::sum_size;
+		static_assert(TileWidth > 0 && TileWidth % type_list_layout<TypeList>::max_align == 0, "Tile width should be a multiple of every type's alignment");
+
+		/* Create empty vector, optionally reserving some initial space. */
+		explicit tiled_parallel_vector_impl(size_type capacity = 0)
+		{
+			reserve(capacity);
+		}
+		explicit tiled_parallel_vector_impl(const Traits &traits, size_type capacity = 0)
+			: Traits(traits)
+		{
+			reserve(capacity);
+		}
+
+		/* Copy constructor and assignment. */
+		tiled_parallel_vector_impl(const tiled_parallel_vector_impl &rhs)
+			: Traits(rhs.traits())
+		{
+			copy_from(rhs);
+		}
+		tiled_parallel_vector_impl &operator=(const tiled_parallel_vector_impl &rhs)
+		{
+			if (this != &rhs)
+			{
+				clear();
+				copy_from(rhs);
+			}
+			return *this;
+		}
+
+		/* Move constructor and assignment. */
+		tiled_parallel_vector_impl(tiled_parallel_vector_impl &&rhs) noexcept
+			: Traits(std::move(static_cast<Traits &>(rhs)))
+			, mMemory(rhs.mMemory)
+			, mSize(rhs.mSize)
+			, mCapacity(rhs.mCapacity)
+		{
+			rhs.mMemory = nullptr;
+			rhs.mSize = rhs.mCapacity = 0;
+		}
+		tiled_parallel_vector_impl &operator=(tiled_parallel_vector_impl &&rhs)
+		{
+			clear();
+			this->deallocate(mMemory);
+
+			static_cast<Traits &>(*this) = std::move(static_cast<Traits &>(rhs));
+			mMemory = rhs.mMemory;
+			mSize = rhs.mSize;
+			mCapacity = rhs.mCapacity;
+
+			rhs.mMemory = nullptr;
+			rhs.mSize = rhs.mCapacity = 0;
+
+			return *this;
+		}
+
+		~tiled_parallel_vector_impl()
+		{
+			clear();
+			this->deallocate(mMemory);
+		}
+
+		/* Access single element by row index. */
+		template<size_t Index> auto &get(size_type row)
+		{
+			return tile_start<Index>(mMemory, row / TileWidth)[row % TileWidth];
+		}
+		template<size_t Index> const auto &get(size_type row) const
+		{
+			return tile_start<Index>(mMemory, row / TileWidth)[row % TileWidth];
+		}
+		template<typename Type> auto &get(size_type row)
+		{
+			return get<find_type_index<Type, TypeList>::value>(row);
+		}
+		template<typename Type> const auto &get(size_type row) const
+		{
+			return get<find_type_index<Type, TypeList>::value>(row);
+		}
+
+		/* Access elements of single field in given tile; the view contains tile_width elements, except for the last tile, which can be partial. */
+		template<size_t Index> auto tile(size_type tileIndex)
+		{
+			return make_array_view(tile_start<Index>(mMemory, tileIndex), tile_rows(tileIndex));
+		}
+		template<size_t Index> auto tile(size_type tileIndex) const
+		{
+			return make_array_view(tile_start<Index>(static_cast<const void *>(mMemory), tileIndex), tile_rows(tileIndex));
+		}
+		template<typename Type> auto tile(size_type tileIndex)
+		{
+			return tile<find_type_index<Type, TypeList>::value>(tileIndex);
+		}
+		template<typename Type> auto tile(size_type tileIndex) const
+		{
+			return tile<find_type_index<Type, TypeList>::value>(tileIndex);
+		}
+
+		/* Call f(tileField0, tileField1, ...) for each non-empty tile, passing views of selected fields (all if Indices is empty). */
+		template<size_t... Indices, typename Func>
+		void for_each_tile(Func &&f)
+		{
+			for_each_tile_impl(*this, f, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+		template<size_t... Indices, typename Func>
+		void for_each_tile(Func &&f) const
+		{
+			for_each_tile_impl(*this, f, std::conditional_t<sizeof...(Indices) == 0, std::make_index_sequence<TypeList::size>, std::index_sequence<Indices...>>());
+		}
+
+		/* Reallocate (if necessary) memory block so that capacity is >= requested. Capacity is always a multiple of tile width. */
+		void reserve(size_type capacity)
+		{
+			if (capacity <= mCapacity)
+				return;
+
+			capacity = static_cast<size_type>((capacity + TileWidth - 1) / TileWidth * TileWidth);
+			void *mem = this->allocate(capacity / TileWidth * tile_bytes);
+			relocate_tiles(mem);
+
+			this->deallocate(mMemory);
+			mMemory = mem;
+			mCapacity = capacity;
+		}
+
+		/* Clear by destroying all elements. Memory is not reclaimed. */
+		void clear()
+		{
+			for_each_field([this](auto index) {
+				for (size_type i = 0; i < mSize; ++i)
+					destroy(&get<decltype(index)::value>(i));
+			});
+			mSize = 0;
+		}
+
+		/* Append new row. Assumes each argument is passed to corresponding type; use std::forward_as_tuple for complex construction. */
+		template<typename... Args>
+		void push_back(Args &&... args)
+		{
+			if (mSize == mCapacity)
+				reserve(grown_capacity(mCapacity, mSize + 1));
+
+			for_each_field([this, argTuple = std::forward_as_tuple(std::forward<Args>(args)...)](auto index) mutable {
+				static constexpr const size_t kIndex = decltype(index)::value;
+				construct(&get<kIndex>(mSize), std::get<kIndex>(std::move(argTuple)));
+			});
+			++mSize;
+		}
+
+		/* Erase last row. */
+		void pop_back()
+		{
+			--mSize;
+			for_each_field([this](auto index) {
+				destroy(&get<decltype(index)::value>(mSize));
+			});
+		}
+
+		/* Information about size & capacity. */
+		bool empty() const { return mSize == 0; }
+		size_type size() const { return mSize; }
+		size_type capacity() const { return mCapacity; }
+		size_type num_tiles() const { return static_cast<size_type>((mSize + TileWidth - 1) / TileWidth); }
+
+		/* Access traits instance used by this vector. */
+		const Traits &traits() const { return *this; }
+
+	private:
+		/* Capacity to grow to from given one, following traits growth policy (same as parallel_vector_impl) and rounded up to whole tiles;
+		 * capacity rounding extends the block up to the next multiple of rounding, leaving some slack for allocator headers. */
+		static size_type grown_capacity(size_type capacity, size_type required)
+		{
+			static const constexpr size_t kMaxTiles = std::numeric_limits<size_type>::max() / TileWidth;
+			static const constexpr size_t kRounding = traits_capacity_rounding<Traits>::value;
+			double grown = double(capacity) * traits_growth_factor<Traits>::value;
+			size_t result = std::max<size_t>(required, size_t(capacity) + traits_growth_min_increment<Traits>::value);
+			if (grown > double(result))
+				result = grown < double(kMaxTiles * TileWidth) ? size_t(grown) : kMaxTiles * TileWidth;
+			size_t numTiles = std::min((result + TileWidth - 1) / TileWidth, kMaxTiles);
+			if constexpr (kRounding > 0)
+			{
+				static const constexpr size_t kSlack = 64;
+				size_t bytes = numTiles * tile_bytes;
+				if (bytes >= kRounding)
+					numTiles = std::min(std::max(numTiles, ((bytes + kSlack + kRounding - 1) / kRounding * kRounding - kSlack) / tile_bytes), kMaxTiles);
+			}
+			return static_cast<size_type>(numTiles * TileWidth);
+		}
+
+		/* Extract pointer to the field array inside given tile. */
+		template<size_t Index>
+		static auto tile_start(void *mem, size_t tileIndex)
+		{
+			void *start = static_cast<char *>(mem) + tileIndex * tile_bytes + TileWidth * type_list_layout<TypeList>::offsets[Index];
+			return static_cast<type_list_element_t<Index, TypeList> *>(start);
+		}
+		template<size_t Index>
+		static auto tile_start(const void *mem, size_t tileIndex)
+		{
+			const void *start = static_cast<const char *>(mem) + tileIndex * tile_bytes + TileWidth * type_list_layout<TypeList>::offsets[Index];
+			return static_cast<const type_list_element_t<Index, TypeList> *>(start);
+		}
+
+		/* Number of rows in given tile. */
+		size_t tile_rows(size_type tileIndex) const
+		{
+			size_t first = size_t(tileIndex) * TileWidth;
+			return mSize - first < TileWidth ? mSize - first : TileWidth;
+		}
+
+		/* Move all existing elements into new memory block. */
+		void relocate_tiles(void *mem)
+		{
+			if (mSize == 0)
+				return;
+
+			if constexpr (all_relocatable(std::make_index_sequence<TypeList::size>()))
+			{
+				std::memcpy(mem, mMemory, num_tiles() * tile_bytes);
+			}
+			else
+			{
+				for_each_field([this, mem](auto index) {
+					static constexpr const size_t kIndex = decltype(index)::value;
+					for (size_type t = 0, numTiles = num_tiles(); t < numTiles; ++t)
+						relocate_range(tile_start<kIndex>(mem, t), tile_start<kIndex>(mMemory, t), tile_rows(t));
+				});
+			}
+		}
+
+		template<size_t... Indices>
+		static constexpr bool all_relocatable(std::index_sequence<Indices...>)
+		{
+			return (is_trivially_relocatable<type_list_element_t<Indices, TypeList>>::value && ...);
+		}
+
+		template<typename Other>
+		void copy_from(const Other &rhs)
+		{
+			reserve(rhs.mSize);
+			for_each_field([this, &rhs](auto index) {
+				static constexpr const size_t kIndex = decltype(index)::value;
+				for (size_type i = 0; i < rhs.mSize; ++i)
+					construct(&get<kIndex>(i), rhs.template get<kIndex>(i));
+			});
+			mSize = rhs.mSize;
+		}
+
+		template<typename Self, typename Func, size_t... Indices>
+		static void for_each_tile_impl(Self &self, Func &f, std::index_sequence<Indices...>)
+		{
+			for (size_type t = 0, numTiles = self.num_tiles(); t < numTiles; ++t)
+				f(self.template tile<Indices>(t)...);
+		}
+
+		/* Execute passed functor for each field. */
+		template<typename Func>
+		static void for_each_field(Func &&f)
+		{
+			seq_call<TypeList::size>::execute(std::forward<Func>(f));
+		}
+
+	private:
+		void		*mMemory	= nullptr;
+		size_type	mSize		= 0;
+		size_type	mCapacity	= 0;
+	};
+}
+
+/* Tiled parallel vector with default traits and given tile width (typically SIMD width in elements, e.g. 8 or 16). */
+template<size_t TileWidth, typename... Types>
+using tiled_parallel_vector = detail::tiled_parallel_vector_impl<detail::type_list<Types...>, default_parallel_vector_traits, TileWidth>;
+
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "parallel_vector.h"
+
+#include <algorithm>
+#include <array>
+#include <stdint.h>
+#include <vector>
+
+namespace utl {
+
+namespace detail {
+	/* Parallel vector with per-chunk change tracking: every slice is split into chunks of ChunkRows rows, each having a version stamp.
+	 * All writes go through write* accessors or modifiers, which stamp touched chunks with a new value of a monotonic version counter; reads through
+	 * const slices are free. Consumers remember version() after processing and later ask which chunks of a slice changed since then,
+	 * so incremental work (cache updates, network sync) is proportional to the change set rather than size().
+	 * Modifiers that move rows (erase, swap_remove) stamp every chunk whose rows changed; shrinking stamps the chunk containing the new end,
+	 * so consumers should compare size as well. Stamping is not synchronized: concurrent writers need external synchronization. */
+	template<typename TypeList, typename Traits, size_t ChunkRows>
+	class tracked_parallel_vector_impl
+	{
+	public:
+		using vector_type = parallel_vector_impl<TypeList, without_auto_shrink_t<Traits>>;
+		using size_type = typename vector_type::size_type;
+		using types = TypeList;
+		using version_type = uint64_t;
+
+		static const constexpr size_t chunk_rows = ChunkRows;
+		static const constexpr size_t num_slices = TypeList::size;
+		static_assert(ChunkRows > 0 && (ChunkRows & (ChunkRows - 1)) == 0, "Chunk size should be power-of-two");
+
+		tracked_parallel_vector_impl() = default;
+		explicit tracked_parallel_vector_impl(const Traits &traits) : mRows(traits) {}
+
+		bool empty() const { return mRows.empty(); }
+		size_type size() const { return mRows.size(); }
+		size_type capacity() const { return mRows.capacity(); }
+		void reserve(size_type capacity) { mRows.reserve(capacity); }
+
+		/* Read-only access; underlying vector is never exposed mutably, so that no write escapes tracking. */
+		const vector_type &rows() const { return mRows; }
+		template<size_t Index> auto slice() const { return mRows.template slice<Index>(); }
+		template<typename Type> auto slice() const { return mRows.template slice<Type>(); }
+		template<size_t Index> const auto &get(size_type row) const { return mRows.template slice<Index>()[row]; }
+		template<typename Type> const auto &get(size_type row) const { return get<find_type_index<Type, TypeList>::value>(row); }
+
+		/* Current version: stamp of the most recent write. */
+		version_type version() const { return mVersion; }
+
+		/* Writable access to single element, rows [first, last) or whole slice; touched chunks are stamped with a new version. */
+		template<size_t Index> auto &write(size_type row)
+		{
+			stamp<Index>(row, row + 1, ++mVersion);
+			return mRows.template slice<Index>()[row];
+		}
+		template<size_t Index> auto write_range(size_type first, size_type last)
+		{
+			stamp<Index>(first, last, ++mVersion);
+			auto slice = mRows.template slice<Index>();
+			return make_array_view(slice.data() + first, last - first);
+		}
+		template<size_t Index> auto write_slice()
+		{
+			stamp<Index>(0, mRows.size(), ++mVersion);
+			return mRows.template slice<Index>();
+		}
+		template<typename Type> auto &write(size_type row) { return write<find_type_index<Type, TypeList>::value>(row); }
+		template<typename Type> auto write_range(size_type first, size_type last) { return write_range<find_type_index<Type, TypeList>::value>(first, last); }
+		template<typename Type> auto write_slice() { return write_slice<find_type_index<Type, TypeList>::value>(); }
+
+		/* Modifiers, same semantics as in parallel_vector_impl; touched rows of all slices are stamped. */
+		template<typename... Args>
+		void push_back(Args &&... args)
+		{
+			mRows.push_back(std::forward<Args>(args)...);
+			stamp_all(mRows.size() - 1, mRows.size());
+		}
+
+		void pop_back()
+		{
+			mRows.pop_back();
+			stamp_end();
+		}
+
+		void erase(size_type begin, size_type end)
+		{
+			size_type oldSize = mRows.size();
+			mRows.erase(begin, end);
+			stamp_all(begin, begin < end ? oldSize : begin);
+		}
+
+		void swap_remove(size_type row)
+		{
+			mRows.swap_remove(row);
+			if (row < mRows.size())
+				stamp_all(row, row + 1);
+			stamp_end();
+		}
+
+		void resize(size_type size)
+		{
+			size_type oldSize = mRows.size();
+			mRows.resize(size);
+			if (size > oldSize)
+				stamp_all(oldSize, size);
+			else if (size < oldSize)
+				stamp_end();
+		}
+
+		void clear()
+		{
+			if (!mRows.empty())
+			{
+				mRows.clear();
+				stamp_end();
+			}
+		}
+
+		/* Number of chunks covering current rows; chunk i contains rows [i * chunk_rows, min(size, (i + 1) * chunk_rows)). */
+		size_t num_chunks() const { return (mRows.size() + ChunkRows - 1) / ChunkRows; }
+
+		/* Version of the last write into given chunk of a slice (0 if never written). */
+		template<size_t Index> version_type chunk_version(size_t chunk) const
+		{
+			auto &stamps = mStamps[Index];
+			return chunk < stamps.size() ? stamps[chunk] : 0;
+		}
+
+		/* Call f(first, last) for row range of every chunk of a slice written after given version (only chunks covering current rows). */
+		template<size_t Index, typename Func>
+		void for_each_changed_chunk(version_type since, Func &&f) const
+		{
+			auto &stamps = mStamps[Index];
+			size_t numChunks = std::min(num_chunks(), stamps.size());
+			for (size_t chunk = 0; chunk < numChunks; ++chunk)
+				if (stamps[chunk] > since)
+					f(static_cast<size_type>(chunk * ChunkRows), static_cast<size_type>(std::min<size_t>(mRows.size(), (chunk + 1) * ChunkRows)));
+		}
+
+		/* Indices of chunks of a slice written after given version. */
+		template<size_t Index>
+		std::vector<size_t> changed_chunks(version_type since) const
+		{
+			std::vector<size_t> result;
+			for_each_changed_chunk<Index>(since, [&](size_type first, size_type) { result.push_back(first / ChunkRows); });
+			return result;
+		}
+
+	private:
+		template<size_t Index>
+		void stamp(size_t first, size_t last, version_type version)
+		{
+			if (first >= last)
+				return;
+			auto &stamps = mStamps[Index];
+			size_t lastChunk = (last - 1) / ChunkRows;
+			if (stamps.size() <= lastChunk)
+				stamps.resize(lastChunk + 1, 0);
+			std::fill(stamps.begin() + first / ChunkRows, stamps.begin() + lastChunk + 1, version);
+		}
+
+		void stamp_all(size_t first, size_t last)
+		{
+			version_type version = ++mVersion;
+			seq_call<TypeList::size>::execute([&](auto sliceIndex) { stamp<decltype(sliceIndex)::value>(first, last, version); });
+		}
+
+		/* Rows were removed from the end: stamp chunk which now contains the end (or the first chunk if vector became empty). */
+		void stamp_end()
+		{
+			size_t end = mRows.size();
+			stamp_all(end > 0 ? end - 1 : 0, end > 0 ? end : 1);
+		}
+
+	private:
+		vector_type												mRows;
+		std::array<std::vector<version_type>, TypeList::size>	mStamps;	// per slice, per chunk
+		version_type											mVersion = 0;
+	};
+}
+
+/* Change-tracked parallel vector with default traits and 1024-row chunks. */
+template<typename... Types>
+using tracked_parallel_vector = detail::tracked_parallel_vector_impl<detail::type_list<Types...>, default_parallel_vector_traits, 1024>;
+
+}
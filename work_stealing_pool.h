@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utl {
+
+/* Executor concept used by parallel algorithms: any object with member
+ *   template<typename Func> void bulk_execute(size_t count, Func &&f);
+ * that calls f(i) exactly once for every i in [0, count), possibly concurrently, and returns after all calls have finished.
+ * User-supplied executors (e.g. adapters for TBB or engine job systems) only need to provide that member. */
+
+/* Trivial executor that runs everything on the calling thread. */
+struct inline_executor
+{
+	template<typename Func>
+	void bulk_execute(size_t count, Func &&f)
+	{
+		for (size_t i = 0; i < count; ++i)
+			f(i);
+	}
+};
+
+/* Thread pool with per-worker task deques and work stealing.
+ * Bulk job is pushed as a single index range; whoever executes a range splits it in halves, keeping lower half and pushing upper half to its own deque.
+ * Owners pop from the back of their deque (most recently split, smallest, hottest in cache), idle workers steal from the front (oldest, largest ranges).
+ * Calling thread participates in execution while waiting, so nested bulk_execute calls from inside tasks are fine.
+ * Exceptions thrown by tasks are captured and the first one is rethrown from bulk_execute after all tasks have finished. */
+class work_stealing_pool
+{
+public:
+	/* Create pool with given number of worker threads (in addition to the calling thread, which helps while waiting). */
+	explicit work_stealing_pool(size_t numThreads = default_num_threads())
+		: mQueues(std::max<size_t>(numThreads, 1))
+	{
+		for (auto &q : mQueues)
+			q = std::make_unique<task_queue>();
+		mThreads.reserve(numThreads);
+		for (size_t i = 0; i < numThreads; ++i)
+			mThreads.emplace_back([this, i] { worker_loop(i); });
+	}
+
+	~work_stealing_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mWakeMutex);
+			mStop = true;
+		}
+		mWake.notify_all();
+		for (auto &t : mThreads)
+			t.join();
+	}
+
+	work_stealing_pool(const work_stealing_pool &) = delete;
+	work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+
+	/* Number of worker threads (not counting calling threads). */
+	size_t num_threads() const { return mThreads.size(); }
+
+	/* Executor interface: call f(i) for every i in [0, count) and wait for completion. */
+	template<typename Func>
+	void bulk_execute(size_t count, Func &&f)
+	{
+		if (count == 0)
+			return;
+
+		using func_type = std::remove_reference_t<Func>;
+		bulk_job job;
+		job.func = const_cast<void *>(static_cast<const void *>(std::addressof(f)));
+		job.invoke = [](void *func, size_t index) { (*static_cast<func_type *>(func))(index); };
+		job.remaining.store(count, std::memory_order_relaxed);
+
+		// start executing the job on calling thread (splitting pushes halves for workers), so nothing is lost if the queue can't accept the range;
+		// then help executing queued tasks (of any job) until our job is done
+		size_t queueIndex = current_queue_index();
+		execute(queueIndex, { &job, 0, count });
+		while (job.remaining.load(std::memory_order_acquire) > 0)
+		{
+			task t;
+			if (try_pop(queueIndex, t))
+				execute(queueIndex, t);
+			else
+				std::this_thread::yield();
+		}
+
+		if (job.error)
+			std::rethrow_exception(job.error);
+	}
+
+	/* Process-wide pool, lazily created with one worker per hardware thread except the caller. */
+	static work_stealing_pool &instance()
+	{
+		static work_stealing_pool pool;
+		return pool;
+	}
+
+	static size_t default_num_threads()
+	{
+		size_t hw = std::thread::hardware_concurrency();
+		return hw > 1 ? hw - 1 : 0;
+	}
+
+private:
+	/* Type-erased bulk job; lives on the stack of bulk_execute caller, which does not return until all its tasks are done. */
+	struct bulk_job
+	{
+		void (*invoke)(void *func, size_t index) = nullptr;
+		void *func = nullptr;
+		std::atomic<size_t> remaining{ 0 };
+		std::mutex errorMutex;
+		std::exception_ptr error;
+	};
+
+	/* Task is a subrange [begin, end) of job indices. */
+	struct task
+	{
+		bulk_job *job;
+		size_t begin;
+		size_t end;
+	};
+
+	struct task_queue
+	{
+		std::mutex mutex;
+		std::deque<task> tasks;
+	};
+
+	/* Queue of the current thread: own queue for workers of this pool, round-robin shared queue for external threads. */
+	size_t current_queue_index()
+	{
+		if (current_worker_pool() == this)
+			return current_worker_index();
+		return mNextExternalQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+	}
+
+	/* Make task available to other threads. Can throw (queue growth); then nothing is queued and counter is restored. */
+	void push(size_t queueIndex, task t)
+	{
+		{
+			// counter is bumped before task becomes visible, so that it never underflows when task is stolen immediately
+			std::lock_guard<std::mutex> lock(mWakeMutex);
+			++mNumQueued;
+		}
+		try
+		{
+			auto &q = *mQueues[queueIndex];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			q.tasks.push_back(t);
+		}
+		catch (...)
+		{
+			mNumQueued.fetch_sub(1, std::memory_order_relaxed);
+			throw;
+		}
+		mWake.notify_one();
+	}
+
+	/* Pop from the back of own queue, otherwise steal from the front of others. */
+	bool try_pop(size_t queueIndex, task &out)
+	{
+		size_t numQueues = mQueues.size();
+		for (size_t i = 0; i < numQueues; ++i)
+		{
+			auto &q = *mQueues[(queueIndex + i) % numQueues];
+			std::lock_guard<std::mutex> lock(q.mutex);
+			if (q.tasks.empty())
+				continue;
+
+			if (i == 0)
+			{
+				out = q.tasks.back();
+				q.tasks.pop_back();
+			}
+			else
+			{
+				out = q.tasks.front();
+				q.tasks.pop_front();
+			}
+			mNumQueued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	/* Split range until single index remains (pushing upper halves for others to steal), then run it.
+	 * If upper half can't be queued, the whole remaining range is run here instead, so that every index is executed exactly once
+	 * and job counter always reaches zero. */
+	void execute(size_t queueIndex, task t)
+	{
+		while (t.end - t.begin > 1)
+		{
+			size_t mid = t.begin + (t.end - t.begin) / 2;
+			try
+			{
+				push(queueIndex, { t.job, mid, t.end });
+			}
+			catch (...)
+			{
+				break;
+			}
+			t.end = mid;
+		}
+
+		bulk_job &job = *t.job;
+		for (size_t i = t.begin; i < t.end; ++i)
+		{
+			try
+			{
+				job.invoke(job.func, i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(job.errorMutex);
+				if (!job.error)
+					job.error = std::current_exception();
+			}
+		}
+		job.remaining.fetch_sub(t.end - t.begin, std::memory_order_release);
+	}
+
+	void worker_loop(size_t index)
+	{
+		current_worker_pool() = this;
+		current_worker_index() = index;
+
+		while (true)
+		{
+			task t;
+			if (try_pop(index, t))
+			{
+				execute(index, t);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(mWakeMutex);
+			mWake.wait(lock, [this] { return mStop || mNumQueued.load(std::memory_order_relaxed) > 0; });
+			if (mStop)
+				return;
+		}
+	}
+
+	static work_stealing_pool *&current_worker_pool()
+	{
+		static thread_local work_stealing_pool *pool = nullptr;
+		return pool;
+	}
+	static size_t &current_worker_index()
+	{
+		static thread_local size_t index = 0;
+		return index;
+	}
+
+private:
+	std::vector<std::unique_ptr<task_queue>>	mQueues;
+	std::vector<std::thread>					mThreads;
+	std::atomic<size_t>							mNextExternalQueue{ 0 };
+	std::atomic<size_t>							mNumQueued{ 0 };
+	std::mutex									mWakeMutex;
+	std::condition_variable						mWake;
+	bool										mStop = false;
+};
+
+}